@@ -0,0 +1,437 @@
+/// File:  bench.cpp
+///
+/// Driver program benchmarking Graph.
+///
+/// Graphs are generated from a fixed seed across a grid of sizes and average
+/// degrees, either joining each pair of cities at random (gnp, see
+/// randomgraphgenerator.h) or joining each city to its nearest cities (knn,
+/// see kdtree.h). Each graph is timed being built, the minimum spanning tree,
+/// breadth first search along the tree and Dijkstra's algorithm from a random
+/// source, and a DisjointSet of each size is timed joining and finding.
+///
+/// Every operation is run a number of times unmeasured to warm up and then a
+/// number of times measured. The median, 90th and 99th percentile, minimum and
+/// mean times, the throughput and the peak resident memory so far are written
+/// as JSON, one result per line so a saved run can be read back as a baseline.
+/// Given a baseline the medians are compared with it, and the program fails
+/// if any operation is slower than the baseline by more than the tolerance.
+///
+/// Usage: bench [--sizes 1000,10000] [--degrees 4,16] [--models gnp,knn]
+///              [--warmup 1] [--repetitions 5] [--seed 1] [--threads 0]
+///              [--output file] [--baseline file] [--tolerance 0.1]
+///
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <sys/resource.h>
+
+#include "graph.h"
+#include "disjointset.h"
+#include "shortestpathtree.h"
+#include "randomgraphgenerator.h"
+#include "kdtree.h"
+#include "random.h"
+#include "pointset.h"
+
+using namespace std;
+
+const double MAXIMUM_COORDINATE = 1000;
+const char* DEFAULT_SIZES = "1000,10000,100000,1000000";
+const char* DEFAULT_DEGREES = "4,16";
+const char* DEFAULT_MODELS = "gnp,knn";
+const int DEFAULT_WARMUP = 1;
+const int DEFAULT_REPETITIONS = 5;
+const double DEFAULT_TOLERANCE = 0.1;
+
+// options given on the command line
+struct Options {
+   vector<unsigned int> sizes;
+   vector<unsigned int> degrees;
+   vector<string> models;
+   int warmup;
+   int repetitions;
+   uint64_t seed;
+   unsigned int threads;
+   string output;
+   string baseline;
+   double tolerance;
+};
+
+// times measured for one operation on one graph
+struct Result {
+   string id;
+   string operation;
+   string model;
+   unsigned int vertices;
+   size_t edges;
+   unsigned int degree;
+   vector<double> seconds;
+   double items;
+   string unit;
+   long peakKilobytes;
+};
+
+// splits a comma separated list
+vector<string> splitList(const string& list) {
+   vector<string> parts;
+   stringstream stream(list);
+   string part;
+   while (getline(stream, part, ',')) {
+      if (!part.empty()) {
+         parts.push_back(part);
+      }
+   }
+   return parts;
+}
+
+// reads the command line, returning false if it is not understood
+bool parseOptions(int argc, char *argv[], Options& options) {
+
+   string sizes = DEFAULT_SIZES;
+   string degrees = DEFAULT_DEGREES;
+   string models = DEFAULT_MODELS;
+   options.warmup = DEFAULT_WARMUP;
+   options.repetitions = DEFAULT_REPETITIONS;
+   options.seed = 1;
+   options.threads = 0;
+   options.tolerance = DEFAULT_TOLERANCE;
+
+   for (int i = 1; i < argc; i++) {
+      if (i + 1 == argc) return false;
+      string option = argv[i];
+      string value = argv[++i];
+      if (option == "--sizes") {
+         sizes = value;
+      } else if (option == "--degrees") {
+         degrees = value;
+      } else if (option == "--models") {
+         models = value;
+      } else if (option == "--warmup") {
+         options.warmup = atoi(value.c_str());
+      } else if (option == "--repetitions") {
+         options.repetitions = atoi(value.c_str());
+      } else if (option == "--seed") {
+         options.seed = strtoull(value.c_str(), NULL, 10);
+      } else if (option == "--threads") {
+         options.threads = atoi(value.c_str());
+      } else if (option == "--output") {
+         options.output = value;
+      } else if (option == "--baseline") {
+         options.baseline = value;
+      } else if (option == "--tolerance") {
+         options.tolerance = atof(value.c_str());
+      } else {
+         return false;
+      }
+   }
+
+   for (const string& size : splitList(sizes)) {
+      options.sizes.push_back(strtoul(size.c_str(), NULL, 10));
+   }
+   for (const string& degree : splitList(degrees)) {
+      options.degrees.push_back(strtoul(degree.c_str(), NULL, 10));
+   }
+   options.models = splitList(models);
+   for (const string& model : options.models) {
+      if (model != "gnp" && model != "knn") return false;
+   }
+   return options.repetitions > 0 && options.warmup >= 0 && !options.sizes.empty();
+}
+
+// peak resident memory of the process so far, in kilobytes
+long peakKilobytes() {
+   struct rusage usage;
+   getrusage(RUSAGE_SELF, &usage);
+   return usage.ru_maxrss;
+}
+
+// seconds since a time point
+double secondsSince(chrono::steady_clock::time_point start) {
+   return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// the time below which a fraction of the sorted times lie, by nearest rank
+double percentile(const vector<double>& sorted, double fraction) {
+   size_t rank = size_t(ceil(fraction * sorted.size()));
+   return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+// creates a result for an operation, to which the times are added
+Result makeResult(const string& operation, const string& model, unsigned int vertices, size_t edges,
+                  unsigned int degree, double items, const string& unit) {
+   Result result;
+   stringstream id;
+   if (model.empty()) {
+      id << operation << "/" << vertices;
+   } else {
+      id << model << "/" << vertices << "/" << degree << "/" << operation;
+   }
+   result.id = id.str();
+   result.operation = operation;
+   result.model = model;
+   result.vertices = vertices;
+   result.edges = edges;
+   result.degree = degree;
+   result.items = items;
+   result.unit = unit;
+   result.peakKilobytes = 0;
+   return result;
+}
+
+// generates the cities and edges of a graph, the same for the same seed
+void generateGraph(const Options& options, const string& model, unsigned int numCities, unsigned int degree,
+                   vector<WeightedEdge>& edges) {
+
+   PointSet cities;
+   vector<double> xs(numCities), ys(numCities);
+   Random random(options.seed);
+   random.randomReals(0, MAXIMUM_COORDINATE, xs.data(), numCities);
+   random.randomReals(0, MAXIMUM_COORDINATE, ys.data(), numCities);
+   cities.reserve(numCities);
+   for (unsigned int i = 0; i < numCities; i++) {
+      cities.add(xs[i], ys[i]);
+   }
+
+   edges.clear();
+   if (model == "gnp") {
+      double p = numCities < 2 ? 0 : min(1.0, double(degree) / (numCities - 1));
+      RandomGraphGenerator generator(random.randomBits());
+      generator.generate(&cities, p, options.threads);
+      edges = generator.getEdges();
+   } else {
+      KdTree tree;
+      tree.build(&cities);
+      tree.nearestNeighbourEdges(degree, options.threads, edges);
+   }
+}
+
+// times building, the minimum spanning tree, breadth first search and
+// Dijkstra's algorithm on one graph, a new graph for every repetition
+void benchmarkGraph(const Options& options, const string& model, unsigned int numCities, unsigned int degree,
+                    vector<Result>& results) {
+
+   vector<WeightedEdge> edges;
+   generateGraph(options, model, numCities, degree, edges);
+   size_t numEdges = edges.size();
+
+   Result build = makeResult("build", model, numCities, numEdges, degree, numEdges, "edges/s");
+   Result mst = makeResult("mst", model, numCities, numEdges, degree, numEdges, "edges/s");
+   Result bfs = makeResult("bfs", model, numCities, numEdges, degree, numCities, "vertices/s");
+   Result dijkstra = makeResult("dijkstra", model, numCities, numEdges, degree, numEdges, "edges/s");
+
+   // sources are drawn from their own stream so every run uses the same
+   Random sources(options.seed, 1);
+   ShortestPathTree tree;
+   double checksum = 0;
+
+   for (int run = 0; run < options.warmup + options.repetitions; run++) {
+      bool measured = run >= options.warmup;
+
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      Graph* graph = new Graph(numCities);
+      graph->reserveVertices(numCities);
+      graph->addEdges(edges.data(), numEdges);
+      graph->getAdjacency();
+      double seconds = secondsSince(start);
+      if (measured) build.seconds.push_back(seconds);
+
+      start = chrono::steady_clock::now();
+      checksum += graph->minimumSpanningTreeCost();
+      seconds = secondsSince(start);
+      if (measured) mst.seconds.push_back(seconds);
+
+      unsigned int source = sources.randomInteger(0, numCities - 1);
+      start = chrono::steady_clock::now();
+      graph->breadthFirstPaths(source, tree);
+      seconds = secondsSince(start);
+      if (measured) bfs.seconds.push_back(seconds);
+
+      source = sources.randomInteger(0, numCities - 1);
+      start = chrono::steady_clock::now();
+      graph->shortestPaths(source, tree);
+      seconds = secondsSince(start);
+      if (measured) dijkstra.seconds.push_back(seconds);
+      checksum += tree.getDistance(numCities - 1);
+
+      delete graph;
+   }
+
+   // the checksum keeps the work from being optimised away
+   if (checksum < 0) cerr << checksum << endl;
+
+   long peak = peakKilobytes();
+   for (Result* result : { &build, &mst, &bfs, &dijkstra }) {
+      result->peakKilobytes = peak;
+      results.push_back(*result);
+   }
+}
+
+// times joining random pairs of a disjoint set and then finding every element
+void benchmarkDisjointSet(const Options& options, unsigned int size, vector<Result>& results) {
+
+   Result result = makeResult("disjointset", "", size, 0, 0, 2.0 * size, "operations/s");
+   vector<int> pairs(2 * size);
+   Random random(options.seed, 2);
+   random.randomIntegers(0, size - 1, pairs.data(), pairs.size());
+   long checksum = 0;
+
+   for (int run = 0; run < options.warmup + options.repetitions; run++) {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      DisjointSet* set = new DisjointSet(size);
+      for (unsigned int i = 0; i < size; i++) {
+         set->join(pairs[2 * i], pairs[2 * i + 1]);
+      }
+      for (unsigned int i = 0; i < size; i++) {
+         checksum += set->find(i);
+      }
+      delete set;
+      double seconds = secondsSince(start);
+      if (run >= options.warmup) result.seconds.push_back(seconds);
+   }
+
+   if (checksum < 0) cerr << checksum << endl;
+   result.peakKilobytes = peakKilobytes();
+   results.push_back(result);
+}
+
+// writes every result as one line of a JSON document
+void writeResults(ostream& out, const Options& options, const vector<Result>& results) {
+
+   out << "{" << endl;
+   out << "  \"seed\": " << options.seed << "," << endl;
+   out << "  \"warmup\": " << options.warmup << "," << endl;
+   out << "  \"repetitions\": " << options.repetitions << "," << endl;
+   out << "  \"instruction_set\": \"" << PointSet::getInstructionSet() << "\"," << endl;
+   out << "  \"peak_rss_kb\": " << peakKilobytes() << "," << endl;
+   out << "  \"results\": [" << endl;
+
+   for (size_t r = 0; r < results.size(); r++) {
+      const Result& result = results[r];
+      vector<double> sorted = result.seconds;
+      sort(sorted.begin(), sorted.end());
+      double median = percentile(sorted, 0.5);
+      double mean = 0;
+      for (double seconds : sorted) {
+         mean += seconds / sorted.size();
+      }
+
+      out << "    {\"id\": \"" << result.id << "\", \"operation\": \"" << result.operation << "\"";
+      if (!result.model.empty()) {
+         out << ", \"model\": \"" << result.model << "\", \"degree\": " << result.degree
+             << ", \"edges\": " << result.edges;
+      }
+      out << ", \"vertices\": " << result.vertices << setprecision(6) << scientific
+          << ", \"median_seconds\": " << median
+          << ", \"p90_seconds\": " << percentile(sorted, 0.9)
+          << ", \"p99_seconds\": " << percentile(sorted, 0.99)
+          << ", \"min_seconds\": " << sorted.front()
+          << ", \"mean_seconds\": " << mean
+          << ", \"throughput\": " << (median > 0 ? result.items / median : 0)
+          << defaultfloat << ", \"throughput_unit\": \"" << result.unit << "\""
+          << ", \"peak_rss_kb\": " << result.peakKilobytes << "}"
+          << (r + 1 < results.size() ? "," : "") << endl;
+   }
+
+   out << "  ]" << endl;
+   out << "}" << endl;
+}
+
+// reads the median of every result of a saved run, false if it cannot be read
+bool readBaseline(const string& fileName, map<string, double>& medians) {
+
+   ifstream in(fileName.c_str());
+   if (!in) return false;
+
+   const string idKey = "\"id\": \"";
+   const string medianKey = "\"median_seconds\": ";
+   string line;
+   while (getline(in, line)) {
+      size_t id = line.find(idKey);
+      size_t median = line.find(medianKey);
+      if (id == string::npos || median == string::npos) continue;
+      id += idKey.size();
+      size_t idEnd = line.find('"', id);
+      medians[line.substr(id, idEnd - id)] = strtod(line.c_str() + median + medianKey.size(), NULL);
+   }
+   return true;
+}
+
+// compares the medians with a baseline, returning the number slower than the tolerance allows
+int compareResults(const vector<Result>& results, const map<string, double>& baseline, double tolerance) {
+
+   int regressions = 0;
+   cerr << left << setw(32) << "Operation" << right << setw(14) << "Baseline (s)"
+        << setw(14) << "Current (s)" << setw(10) << "Change" << endl;
+
+   for (const Result& result : results) {
+      map<string, double>::const_iterator it = baseline.find(result.id);
+      if (it == baseline.end() || it->second <= 0) continue;
+
+      vector<double> sorted = result.seconds;
+      sort(sorted.begin(), sorted.end());
+      double median = percentile(sorted, 0.5);
+      double change = median / it->second - 1;
+      bool regressed = change > tolerance;
+      regressions += regressed;
+
+      cerr << left << setw(32) << result.id << right << scientific << setprecision(3)
+           << setw(14) << it->second << setw(14) << median << fixed << setprecision(1)
+           << setw(9) << 100 * change << "%" << (regressed ? "  REGRESSION" : "") << endl;
+   }
+   return regressions;
+}
+
+int main(int argc, char *argv[]) {
+
+   Options options;
+   if (!parseOptions(argc, argv, options)) {
+      cerr << "Usage: " << argv[0] << " [--sizes 1000,10000] [--degrees 4,16] [--models gnp,knn]" << endl
+           << "       [--warmup 1] [--repetitions 5] [--seed 1] [--threads 0]" << endl
+           << "       [--output file] [--baseline file] [--tolerance 0.1]" << endl;
+      return 1;
+   }
+
+   map<string, double> baseline;
+   if (!options.baseline.empty() && !readBaseline(options.baseline, baseline)) {
+      cerr << "Error: Could not read baseline " << options.baseline << endl;
+      return 1;
+   }
+
+   vector<Result> results;
+   for (unsigned int size : options.sizes) {
+      if (size < 2) continue;
+      for (const string& model : options.models) {
+         for (unsigned int degree : options.degrees) {
+            cerr << model << " " << size << " cities, degree " << degree << endl;
+            benchmarkGraph(options, model, size, degree, results);
+         }
+      }
+      benchmarkDisjointSet(options, size, results);
+   }
+
+   if (options.output.empty()) {
+      writeResults(cout, options, results);
+   } else {
+      ofstream out(options.output.c_str());
+      writeResults(out, options, results);
+      if (!out) {
+         cerr << "Error: Could not write file " << options.output << endl;
+         return 1;
+      }
+   }
+
+   if (!options.baseline.empty() && compareResults(results, baseline, options.tolerance) > 0) {
+      return 1;
+   }
+   return 0;
+}
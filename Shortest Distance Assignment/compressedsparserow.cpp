@@ -0,0 +1,181 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: compressedsparserow.cpp
+/// Implementation of CompressedSparseRow class
+/// Encapsulates the adjacency of a graph in compressed sparse
+/// row form, three contiguous arrays of row offsets, neighbour
+/// identifiers and edge weights
+
+#include <cstddef>
+
+#include "compressedsparserow.h"
+
+/// Encapsulates the adjacency of an undirected graph in compressed sparse
+/// row (CSR) form. The neighbours of vertex v are stored in the index
+/// range [offsets[v], offsets[v + 1]) of the targets and weights arrays,
+/// so memory grows with the number of edges rather than vertices squared.
+/// The arrays are either built and owned by the store or viewed in place,
+/// such as in a memory mapped graph file, without being copied
+
+/// \brief
+///
+/// Constructor, initializes an empty adjacency store
+CompressedSparseRow::CompressedSparseRow(){
+    numVertices = 0;
+    offsets.assign(1, 0);
+    offsetData = offsets.data();
+    targetData = targets.data();
+    weightData = weights.data();
+    edgeIdData = edgeIds.data();
+}
+
+/// \brief
+///
+/// Destructor, no objects dynamically created from this class
+CompressedSparseRow::~CompressedSparseRow(){
+}
+
+/// \brief
+///
+/// Rebuilds the adjacency arrays from a list of undirected edges,
+/// each edge is stored in the rows of both of its end points
+/// \param unsigned int numVertices - number of vertices (rows)
+/// \param const WeightedEdge* edges - edges to be stored
+/// \param unsigned int numEdges - number of edges
+void CompressedSparseRow::build(unsigned int numVertices, const WeightedEdge* edges, unsigned int numEdges){
+
+    this->numVertices = numVertices;
+
+    // Count the degree of every vertex, shifted by one
+    // so the prefix sum below yields the row offsets
+    offsets.assign(numVertices + 1, 0);
+    for (unsigned i = 0; i < numEdges; i++) {
+        offsets[edges[i].source + 1]++;
+        offsets[edges[i].destination + 1]++;
+    }
+
+    for (unsigned v = 0; v < numVertices; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    // Scatter both directions of every edge into its rows,
+    // using a cursor per row that starts at the row offset
+    targets.resize(offsets[numVertices]);
+    weights.resize(offsets[numVertices]);
+    edgeIds.resize(offsets[numVertices]);
+    std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+
+    for (unsigned i = 0; i < numEdges; i++) {
+        const WeightedEdge& e = edges[i];
+
+        unsigned int slot = cursor[e.source]++;
+        targets[slot] = e.destination;
+        weights[slot] = e.weight;
+        edgeIds[slot] = i;
+
+        slot = cursor[e.destination]++;
+        targets[slot] = e.source;
+        weights[slot] = e.weight;
+        edgeIds[slot] = i;
+    }
+
+    offsetData = offsets.data();
+    targetData = targets.data();
+    weightData = weights.data();
+    edgeIdData = edgeIds.data();
+}
+
+/// \brief
+///
+/// Uses adjacency arrays held elsewhere in place of its own,
+/// releasing any it built
+/// \pre - the arrays outlive their use through the store
+/// \param unsigned int numVertices - number of vertices (rows)
+/// \param const unsigned int* offsets - row offsets, numVertices + 1 of them
+/// \param const unsigned int* targets - neighbour identifiers
+/// \param const double* weights - edge weights, parallel to the targets
+void CompressedSparseRow::view(unsigned int numVertices, const unsigned int* offsets, const unsigned int* targets,
+                               const double* weights){
+
+    this->numVertices = numVertices;
+    std::vector<unsigned int>().swap(this->offsets);
+    std::vector<unsigned int>().swap(this->targets);
+    std::vector<double>().swap(this->weights);
+    std::vector<unsigned int>().swap(edgeIds);
+
+    offsetData = offsets;
+    targetData = targets;
+    weightData = weights;
+    edgeIdData = NULL;
+}
+
+/// \brief
+///
+/// Simple getter for the number of vertices (rows)
+/// \return unsigned int - number of vertices
+unsigned int CompressedSparseRow::getNumVertices(){
+    return numVertices;
+}
+
+/// \brief
+///
+/// Simple getter for the row offsets array, of size numVertices + 1
+/// \return const unsigned int* - pointer to the first offset
+const unsigned int* CompressedSparseRow::getOffsets(){
+    return offsetData;
+}
+
+/// \brief
+///
+/// Simple getter for the neighbour identifiers array
+/// \return const unsigned int* - pointer to the first neighbour
+const unsigned int* CompressedSparseRow::getTargets(){
+    return targetData;
+}
+
+/// \brief
+///
+/// Simple getter for the edge weights array, parallel to the targets
+/// \return const double* - pointer to the first weight
+const double* CompressedSparseRow::getWeights(){
+    return weightData;
+}
+
+/// \brief
+///
+/// Simple getter for the edge indices array, parallel to the targets,
+/// giving the index in the edge list each slot was built from
+/// \return const unsigned int* - pointer to the first index, or NULL
+/// if the arrays are viewed rather than built
+const unsigned int* CompressedSparseRow::getEdgeIds(){
+    return edgeIdData;
+}
+
+/// \brief
+///
+/// Changes the weight stored in one slot of the arrays built
+/// \pre - the arrays were built rather than viewed
+/// \param unsigned int slot - index of the slot in the targets array
+/// \param double weight - new weight of the edge
+void CompressedSparseRow::setWeight(unsigned int slot, double weight){
+    weights[slot] = weight;
+}
+
+/// \brief
+///
+/// Looks up the lightest edge between two vertices by scanning the
+/// row of the first vertex
+/// \param unsigned int u - first vertex's ID
+/// \param unsigned int v - second vertex's ID
+/// \param double missing - value returned when there is no such edge
+/// \return double - weight of the lightest edge, or missing
+double CompressedSparseRow::weightBetween(unsigned int u, unsigned int v, double missing){
+
+    double lightest = missing;
+    for (unsigned i = offsetData[u]; i < offsetData[u + 1]; i++) {
+        if (targetData[i] == v && weightData[i] < lightest) {
+            lightest = weightData[i];
+        }
+    }
+    return lightest;
+}
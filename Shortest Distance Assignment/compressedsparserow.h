@@ -0,0 +1,127 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: compressedsparserow.h
+/// Header of CompressedSparseRow class
+/// Encapsulates the adjacency of a graph in compressed sparse
+/// row form, three contiguous arrays of row offsets, neighbour
+/// identifiers and edge weights
+
+#ifndef _compressedsparserow_h
+#define _compressedsparserow_h
+
+#include <vector>
+
+#include "edge.h"
+
+/// Encapsulates the adjacency of an undirected graph in compressed sparse
+/// row (CSR) form. The neighbours of vertex v are stored in the index
+/// range [offsets[v], offsets[v + 1]) of the targets and weights arrays,
+/// so memory grows with the number of edges rather than vertices squared.
+/// The arrays are either built and owned by the store or viewed in place,
+/// such as in a memory mapped graph file, without being copied
+class CompressedSparseRow {
+
+    public:
+
+        /// \brief
+        ///
+        /// Constructor, initializes an empty adjacency store
+        CompressedSparseRow();
+
+        /// \brief
+        ///
+        /// Destructor, no objects dynamically created from this class
+        ~CompressedSparseRow();
+
+        /// \brief
+        ///
+        /// Rebuilds the adjacency arrays from a list of undirected edges,
+        /// each edge is stored in the rows of both of its end points
+        /// \param unsigned int numVertices - number of vertices (rows)
+        /// \param const WeightedEdge* edges - edges to be stored
+        /// \param unsigned int numEdges - number of edges
+        void build(unsigned int numVertices, const WeightedEdge* edges, unsigned int numEdges);
+
+        /// \brief
+        ///
+        /// Uses adjacency arrays held elsewhere in place of its own,
+        /// releasing any it built
+        /// \pre - the arrays outlive their use through the store
+        /// \param unsigned int numVertices - number of vertices (rows)
+        /// \param const unsigned int* offsets - row offsets, numVertices + 1 of them
+        /// \param const unsigned int* targets - neighbour identifiers
+        /// \param const double* weights - edge weights, parallel to the targets
+        void view(unsigned int numVertices, const unsigned int* offsets, const unsigned int* targets,
+                  const double* weights);
+
+        /// \brief
+        ///
+        /// Simple getter for the number of vertices (rows)
+        /// \return unsigned int - number of vertices
+        unsigned int getNumVertices();
+
+        /// \brief
+        ///
+        /// Simple getter for the row offsets array, of size numVertices + 1
+        /// \return const unsigned int* - pointer to the first offset
+        const unsigned int* getOffsets();
+
+        /// \brief
+        ///
+        /// Simple getter for the neighbour identifiers array
+        /// \return const unsigned int* - pointer to the first neighbour
+        const unsigned int* getTargets();
+
+        /// \brief
+        ///
+        /// Simple getter for the edge weights array, parallel to the targets
+        /// \return const double* - pointer to the first weight
+        const double* getWeights();
+
+        /// \brief
+        ///
+        /// Simple getter for the edge indices array, parallel to the targets,
+        /// giving the index in the edge list each slot was built from
+        /// \return const unsigned int* - pointer to the first index, or NULL
+        /// if the arrays are viewed rather than built
+        const unsigned int* getEdgeIds();
+
+        /// \brief
+        ///
+        /// Changes the weight stored in one slot of the arrays built
+        /// \pre - the arrays were built rather than viewed
+        /// \param unsigned int slot - index of the slot in the targets array
+        /// \param double weight - new weight of the edge
+        void setWeight(unsigned int slot, double weight);
+
+        /// \brief
+        ///
+        /// Looks up the lightest edge between two vertices by scanning the
+        /// row of the first vertex
+        /// \param unsigned int u - first vertex's ID
+        /// \param unsigned int v - second vertex's ID
+        /// \param double missing - value returned when there is no such edge
+        /// \return double - weight of the lightest edge, or missing
+        double weightBetween(unsigned int u, unsigned int v, double missing);
+
+    private:
+
+        // Instance variables storing the number of rows and the
+        // offsets, neighbour identifiers, weights and edge indices
+        // arrays built
+        unsigned int numVertices;
+        std::vector<unsigned int> offsets;
+        std::vector<unsigned int> targets;
+        std::vector<double> weights;
+        std::vector<unsigned int> edgeIds;
+
+        // Instance variables pointing to the arrays in use,
+        // either those built or those viewed
+        const unsigned int* offsetData;
+        const unsigned int* targetData;
+        const double* weightData;
+        const unsigned int* edgeIdData;
+
+};
+
+#endif // _compressedsparserow_h
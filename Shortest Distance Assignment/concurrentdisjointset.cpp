@@ -0,0 +1,167 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: concurrentdisjointset.cpp
+/// Implementation of ConcurrentDisjointSet class
+/// Encapsulates a disjoint set data structure that
+/// many threads can find and join in at the same time
+
+#include "concurrentdisjointset.h"
+
+// Constant defining how many pairs each worker claims at a time in joinMany
+const unsigned int PAIRS_PER_TASK = 1024;
+
+/// Encapsulates a disjoint set data structure shared between threads without
+/// a lock. Every parent link is atomic, a join links one root below another
+/// with a single compare and swap and retries if either root was linked
+/// elsewhere first, and finds compress the path they walk by path splitting.
+/// Roots are linked in a fixed pseudo-random priority order, in place of the
+/// sizes kept by DisjointSet, so trees stay shallow without a second array
+/// that would need updating together with the link
+
+/// \brief
+///
+/// Constructor, initializes the disjoint set
+/// of a specified size with every element on its own
+/// \param unsigned int - size of disjoint set
+ConcurrentDisjointSet::ConcurrentDisjointSet(unsigned int N){
+    this->N = N;
+
+    parent = new std::atomic<unsigned int>[N];
+
+    for (unsigned int i = 0; i < N; i++) {
+        parent[i].store(i, std::memory_order_relaxed);
+    }
+}
+
+/// \brief
+///
+/// Destructor, deletes the array created
+ConcurrentDisjointSet::~ConcurrentDisjointSet(){
+    delete[] parent;
+}
+
+/// \brief
+///
+/// Simple getter for the number of elements
+/// \return unsigned int - number of elements
+unsigned int ConcurrentDisjointSet::getSize(){
+    return N;
+}
+
+/// \brief
+///
+/// Algorithm for determining which subset an element is in,
+/// safe to call while other threads join
+/// \param unsigned int i - element
+/// \return unsigned int - subset
+unsigned int ConcurrentDisjointSet::find(unsigned int i){
+
+    while (true) {
+        unsigned int p = parent[i].load(std::memory_order_acquire);
+        if (p == i) return i;
+
+        // Point the element at its grandparent, a failed swap only means
+        // another thread already moved it further up, so it is not retried
+        unsigned int g = parent[p].load(std::memory_order_acquire);
+        if (g != p) {
+            parent[i].compare_exchange_weak(p, g, std::memory_order_release, std::memory_order_relaxed);
+        }
+        i = p;
+    }
+}
+
+/// \brief
+///
+/// Algorithm to union two elements' subsets into a single
+/// subset, safe to call while other threads find and join
+/// \param unsigned int p - first element
+/// \param unsigned int q - second element
+/// \return bool - true if this call joined the subsets, false
+/// if they were already one
+bool ConcurrentDisjointSet::join(unsigned int p, unsigned int q){
+
+    while (true) {
+        unsigned int i = find(p);
+        unsigned int j = find(q);
+        if (i == j) return false;
+
+        // Link the root of lower priority below the other, which fails
+        // if another thread linked it first and then the roots are found again
+        if (priority(i) > priority(j)) {
+            unsigned int t = i;
+            i = j;
+            j = t;
+        }
+        unsigned int expected = i;
+        if (parent[i].compare_exchange_strong(expected, j, std::memory_order_acq_rel)) {
+            return true;
+        }
+        p = i;
+        q = j;
+    }
+}
+
+/// \brief
+///
+/// Compare two subsets based on the specified element, safe to
+/// call while other threads join
+/// \param unsigned int p - first element
+/// \param unsigned int q - second element
+/// \return bool - true if elements belong to the same subset
+bool ConcurrentDisjointSet::sameComponent(unsigned int p, unsigned int q){
+
+    // Different roots only prove the subsets differ if the first root was
+    // still a root after the second was found, otherwise look again
+    while (true) {
+        unsigned int i = find(p);
+        unsigned int j = find(q);
+        if (i == j) return true;
+        if (parent[i].load(std::memory_order_acquire) == i) return false;
+        p = i;
+    }
+}
+
+/// \brief
+///
+/// Joins the subsets of many pairs of elements across a pool of threads
+/// \param const unsigned int* pairs - the two elements of each pair in turn
+/// \param unsigned int count - number of pairs
+/// \param ThreadPool& pool - threads to use
+/// \param char* joined - set to 1 for each pair whose join joined two
+/// subsets and 0 otherwise, or NULL if not needed
+/// \return unsigned int - number of pairs that joined two subsets
+unsigned int ConcurrentDisjointSet::joinMany(const unsigned int* pairs, unsigned int count, ThreadPool& pool,
+                                             char* joined){
+
+    std::atomic<unsigned int> numJoined(0);
+    unsigned int numTasks = (count + PAIRS_PER_TASK - 1) / PAIRS_PER_TASK;
+
+    pool.parallelFor(numTasks, [&](unsigned int task, unsigned int) {
+        unsigned int begin = task * PAIRS_PER_TASK;
+        unsigned int end = begin + PAIRS_PER_TASK < count ? begin + PAIRS_PER_TASK : count;
+
+        unsigned int local = 0;
+        for (unsigned int k = begin; k < end; k++) {
+            bool result = join(pairs[2 * k], pairs[2 * k + 1]);
+            if (joined != NULL) joined[k] = result;
+            local += result;
+        }
+        numJoined.fetch_add(local, std::memory_order_relaxed);
+    });
+
+    return numJoined.load();
+}
+
+/// \brief
+///
+/// Fixed priority of an element deciding which of two roots is
+/// linked below the other, distinct for every element
+/// \param unsigned int - element
+/// \return unsigned int - priority
+unsigned int ConcurrentDisjointSet::priority(unsigned int i){
+
+    // Multiplying by an odd constant and folding the high bits down
+    // are both reversible, so no two elements share a priority
+    unsigned int x = i * 0x9E3779B1u;
+    return x ^ (x >> 16);
+}
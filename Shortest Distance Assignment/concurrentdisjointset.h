@@ -0,0 +1,103 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: concurrentdisjointset.h
+/// Header of ConcurrentDisjointSet class
+/// Encapsulates a disjoint set data structure that
+/// many threads can find and join in at the same time
+
+#ifndef _concurrentdisjointset_h
+#define _concurrentdisjointset_h
+
+#include <atomic>
+
+#include "threadpool.h"
+
+/// Encapsulates a disjoint set data structure shared between threads without
+/// a lock. Every parent link is atomic, a join links one root below another
+/// with a single compare and swap and retries if either root was linked
+/// elsewhere first, and finds compress the path they walk by path splitting.
+/// Roots are linked in a fixed pseudo-random priority order, in place of the
+/// sizes kept by DisjointSet, so trees stay shallow without a second array
+/// that would need updating together with the link
+class ConcurrentDisjointSet {
+
+    public:
+
+        /// \brief
+        ///
+        /// Constructor, initializes the disjoint set
+        /// of a specified size with every element on its own
+        /// \param unsigned int - size of disjoint set
+        ConcurrentDisjointSet(unsigned int);
+
+        /// \brief
+        ///
+        /// Destructor, deletes the array created
+        ~ConcurrentDisjointSet();
+
+        /// \brief
+        ///
+        /// Simple getter for the number of elements
+        /// \return unsigned int - number of elements
+        unsigned int getSize();
+
+        /// \brief
+        ///
+        /// Algorithm for determining which subset an element is in,
+        /// safe to call while other threads join
+        /// \param unsigned int i - element
+        /// \return unsigned int - subset
+        unsigned int find(unsigned int i);
+
+        /// \brief
+        ///
+        /// Algorithm to union two elements' subsets into a single
+        /// subset, safe to call while other threads find and join
+        /// \param unsigned int p - first element
+        /// \param unsigned int q - second element
+        /// \return bool - true if this call joined the subsets, false
+        /// if they were already one
+        bool join(unsigned int p, unsigned int q);
+
+        /// \brief
+        ///
+        /// Compare two subsets based on the specified element, safe to
+        /// call while other threads join
+        /// \param unsigned int p - first element
+        /// \param unsigned int q - second element
+        /// \return bool - true if elements belong to the same subset
+        bool sameComponent(unsigned int p, unsigned int q);
+
+        /// \brief
+        ///
+        /// Joins the subsets of many pairs of elements across a pool of threads
+        /// \param const unsigned int* pairs - the two elements of each pair in turn
+        /// \param unsigned int count - number of pairs
+        /// \param ThreadPool& pool - threads to use
+        /// \param char* joined - set to 1 for each pair whose join joined two
+        /// subsets and 0 otherwise, or NULL if not needed
+        /// \return unsigned int - number of pairs that joined two subsets
+        unsigned int joinMany(const unsigned int* pairs, unsigned int count, ThreadPool& pool, char* joined);
+
+    private:
+
+        // Instance variables storing the number of elements and
+        // the parent of each, which is itself for the roots
+        unsigned int N;
+        std::atomic<unsigned int>* parent;
+
+        /// \brief
+        ///
+        /// Fixed priority of an element deciding which of two roots is
+        /// linked below the other, distinct for every element
+        /// \param unsigned int - element
+        /// \return unsigned int - priority
+        unsigned int priority(unsigned int);
+
+        // Copying would share the parent array
+        ConcurrentDisjointSet(const ConcurrentDisjointSet&);
+        ConcurrentDisjointSet& operator=(const ConcurrentDisjointSet&);
+
+};
+
+#endif // _concurrentdisjointset_h
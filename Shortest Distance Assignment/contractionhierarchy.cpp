@@ -0,0 +1,562 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: contractionhierarchy.cpp
+/// Implementation of ContractionHierarchy class
+/// Encapsulates a contraction hierarchy built from a graph,
+/// preprocessed once so that point to point shortest path
+/// queries only search upwards through a small part of it
+
+#include "contractionhierarchy.h"
+#include "threadpool.h"
+
+// Constants limiting the vertices settled by one witness search, a search
+// cut short only adds a shortcut that was not needed, never loses a path.
+// Estimating priorities runs far more often than contraction, so it uses
+// the tighter limit and may overcount shortcuts slightly
+const unsigned int SIMULATION_SETTLE_LIMIT = 20;
+const unsigned int CONTRACTION_SETTLE_LIMIT = 200;
+
+/// Encapsulates a contraction hierarchy. Preprocessing removes (contracts)
+/// the vertices one by one in order of edge difference, the number of
+/// shortcuts contracting a vertex would add less the edges it removes,
+/// adding a shortcut between two neighbours wherever the path through the
+/// contracted vertex is the only shortest one. Independent sets of vertices
+/// are contracted together across threads. Every edge and shortcut is kept
+/// with the endpoint contracted first, so a query runs Dijkstra's algorithm
+/// upwards from both ends and shortcuts are unpacked into original edges.
+/// The working state of each query is kept in a query context, so once built
+/// any number of threads can query the hierarchy at once, each with its own
+
+/// \brief
+///
+/// Constructor, initializes an empty hierarchy
+ContractionHierarchy::ContractionHierarchy(){
+    numVertices = 0;
+    numShortcuts = 0;
+    offsets.assign(1, 0);
+}
+
+/// \brief
+///
+/// Destructor, no objects dynamically created from this class
+ContractionHierarchy::~ContractionHierarchy(){
+}
+
+/// \brief
+///
+/// Builds the hierarchy from the edges of a graph, replacing any
+/// hierarchy built before
+/// \param Graph& graph - graph to be preprocessed
+/// \param unsigned int numThreads - number of threads to use,
+/// 0 for one per hardware thread
+void ContractionHierarchy::build(Graph& graph, unsigned int numThreads){
+
+    numVertices = graph.getNumVertices();
+    numShortcuts = 0;
+
+    CompressedSparseRow& adjacency = graph.getAdjacency();
+    const unsigned int* graphOffsets = adjacency.getOffsets();
+    const unsigned int* graphTargets = adjacency.getTargets();
+    const double* graphWeights = adjacency.getWeights();
+
+    // Copy the graph into per vertex edge lists that can shrink and grow,
+    // dropping loops and keeping only the lightest of parallel edges
+    std::vector<std::vector<Arc> > arcs(numVertices);
+    std::vector<unsigned int> slot(numVertices, NOT_IN_HEAP);
+
+    for (unsigned int v = 0; v < numVertices; v++) {
+        for (unsigned i = graphOffsets[v]; i < graphOffsets[v + 1]; i++) {
+            unsigned int u = graphTargets[i];
+            if (u == v) continue;
+
+            if (slot[u] == NOT_IN_HEAP) {
+                Arc arc;
+                arc.target = u;
+                arc.weight = graphWeights[i];
+                arc.middle = NOT_IN_HEAP;
+                slot[u] = arcs[v].size();
+                arcs[v].push_back(arc);
+            } else if (graphWeights[i] < arcs[v][slot[u]].weight) {
+                arcs[v][slot[u]].weight = graphWeights[i];
+            }
+        }
+        for (unsigned i = 0; i < arcs[v].size(); i++) {
+            slot[arcs[v][i].target] = NOT_IN_HEAP;
+        }
+    }
+
+    // Give every worker its own witness search state
+    ThreadPool pool(numThreads);
+    std::vector<WitnessSearch> searches(pool.getNumWorkers());
+    for (unsigned i = 0; i < searches.size(); i++) {
+        searches[i].distance.assign(numVertices, INFINITY);
+        searches[i].isTarget.assign(numVertices, 0);
+        searches[i].queue.resize(numVertices);
+    }
+    std::vector<std::vector<Shortcut> > found(pool.getNumWorkers());
+
+    // The priority of a vertex is its edge difference plus the number of its
+    // neighbours already contracted, which spreads contraction evenly
+    std::vector<char> blocked(numVertices, 0);
+    std::vector<char> isChanged(numVertices, 0);
+    std::vector<int> deletedNeighbours(numVertices, 0);
+    std::vector<int> priority(numVertices);
+
+    pool.parallelFor(numVertices, [&](unsigned int v, unsigned int worker) {
+        priority[v] = findShortcuts(v, arcs, blocked, searches[worker], NULL) - (int) arcs[v].size();
+    });
+
+    std::vector<unsigned int> remaining(numVertices);
+    for (unsigned int v = 0; v < numVertices; v++) {
+        remaining[v] = v;
+    }
+
+    std::vector<std::vector<Arc> > upward(numVertices);
+    std::vector<unsigned int> batch;
+    std::vector<unsigned int> rest;
+    std::vector<unsigned int> changed;
+    std::vector<char> chosen;
+    unsigned int nextRank = 0;
+    rank.assign(numVertices, 0);
+
+    while (!remaining.empty()) {
+
+        // Choose every vertex whose priority is lower than all of its
+        // neighbours', no two of these are adjacent and the lowest
+        // priority vertex is always among them
+        chosen.assign(remaining.size(), 0);
+        pool.parallelFor(remaining.size(), [&](unsigned int i, unsigned int) {
+            unsigned int v = remaining[i];
+            bool lowest = true;
+            for (unsigned a = 0; a < arcs[v].size() && lowest; a++) {
+                unsigned int u = arcs[v][a].target;
+                if (priority[u] < priority[v] || (priority[u] == priority[v] && u < v)) {
+                    lowest = false;
+                }
+            }
+            chosen[i] = lowest;
+        });
+
+        batch.clear();
+        rest.clear();
+        for (unsigned i = 0; i < remaining.size(); i++) {
+            if (chosen[i]) {
+                batch.push_back(remaining[i]);
+                blocked[remaining[i]] = 1;
+            } else {
+                rest.push_back(remaining[i]);
+            }
+        }
+
+        // Find the shortcuts of the whole set in parallel, the witness
+        // searches avoid every vertex of the set so the shortcuts stay
+        // valid when the set is removed at once
+        for (unsigned i = 0; i < found.size(); i++) {
+            found[i].clear();
+        }
+        pool.parallelFor(batch.size(), [&](unsigned int i, unsigned int worker) {
+            findShortcuts(batch[i], arcs, blocked, searches[worker], &found[worker]);
+        });
+
+        // Remove the set from the graph, keeping each vertex's remaining
+        // edges as its upward edges since its neighbours are ranked higher
+        for (unsigned i = 0; i < batch.size(); i++) {
+            unsigned int v = batch[i];
+            rank[v] = nextRank++;
+
+            for (unsigned a = 0; a < arcs[v].size(); a++) {
+                unsigned int u = arcs[v][a].target;
+                std::vector<Arc>& list = arcs[u];
+                for (unsigned b = 0; b < list.size(); b++) {
+                    if (list[b].target == v) {
+                        list[b] = list.back();
+                        list.pop_back();
+                        break;
+                    }
+                }
+                deletedNeighbours[u]++;
+                if (!isChanged[u]) {
+                    isChanged[u] = 1;
+                    changed.push_back(u);
+                }
+            }
+            upward[v].swap(arcs[v]);
+        }
+
+        for (unsigned w = 0; w < found.size(); w++) {
+            for (unsigned i = 0; i < found[w].size(); i++) {
+                Shortcut& s = found[w][i];
+                Arc arc;
+                arc.weight = s.weight;
+                arc.middle = s.middle;
+                arc.target = s.target;
+                mergeArc(arcs[s.source], arc);
+                arc.target = s.source;
+                mergeArc(arcs[s.target], arc);
+            }
+        }
+
+        for (unsigned i = 0; i < batch.size(); i++) {
+            blocked[batch[i]] = 0;
+        }
+        for (unsigned i = 0; i < changed.size(); i++) {
+            isChanged[changed[i]] = 0;
+        }
+
+        // Neighbours of the removed vertices lost edges and gained shortcuts,
+        // so their priorities are brought up to date
+        pool.parallelFor(changed.size(), [&](unsigned int i, unsigned int worker) {
+            unsigned int u = changed[i];
+            priority[u] = findShortcuts(u, arcs, blocked, searches[worker], NULL)
+                          - (int) arcs[u].size() + deletedNeighbours[u];
+        });
+        changed.clear();
+
+        remaining.swap(rest);
+    }
+
+    // Pack the upward edges into compressed sparse row arrays, counting
+    // the shortcuts among them, a shortcut replaced by a shorter one
+    // between the same vertices or never added not counted
+    offsets.assign(numVertices + 1, 0);
+    for (unsigned int v = 0; v < numVertices; v++) {
+        offsets[v + 1] = offsets[v] + upward[v].size();
+    }
+
+    targets.resize(offsets[numVertices]);
+    weights.resize(offsets[numVertices]);
+    middles.resize(offsets[numVertices]);
+    for (unsigned int v = 0; v < numVertices; v++) {
+        for (unsigned a = 0; a < upward[v].size(); a++) {
+            targets[offsets[v] + a] = upward[v][a].target;
+            weights[offsets[v] + a] = upward[v][a].weight;
+            middles[offsets[v] + a] = upward[v][a].middle;
+            if (upward[v][a].middle != NOT_IN_HEAP) {
+                numShortcuts++;
+            }
+        }
+        std::vector<Arc>().swap(upward[v]);
+    }
+
+    // Resolve each shortcut to the two edges of its middle vertex it stands
+    // for, the half joining the vertex holding it and the half joining its target
+    ownerHalf.assign(offsets[numVertices], NOT_IN_HEAP);
+    targetHalf.assign(offsets[numVertices], NOT_IN_HEAP);
+    for (unsigned int v = 0; v < numVertices; v++) {
+        for (unsigned i = offsets[v]; i < offsets[v + 1]; i++) {
+            if (middles[i] != NOT_IN_HEAP) {
+                ownerHalf[i] = findEdge(middles[i], v);
+                targetHalf[i] = findEdge(middles[i], targets[i]);
+            }
+        }
+    }
+}
+
+/// \brief
+///
+/// Calculates the minimum distance and path between two vertices
+/// \pre - hierarchy built
+/// \param unsigned int source - source vertex's ID
+/// \param unsigned int target - target vertex's ID
+/// \param vector<unsigned int>& path - filled with the vertex IDs
+/// from source to target, left empty if there is no path
+/// \return double - distance of the path, INFINITY if there is no path
+double ContractionHierarchy::query(unsigned int source, unsigned int target, std::vector<unsigned int>& path){
+    return query(source, target, path, context);
+}
+
+/// \brief
+///
+/// Calculates the minimum distance and path between two vertices
+/// \pre - hierarchy built
+/// \param unsigned int source - source vertex's ID
+/// \param unsigned int target - target vertex's ID
+/// \param vector<unsigned int>& path - filled with the vertex IDs
+/// from source to target, left empty if there is no path
+/// \param QueryContext& context - context holding the working state of the search
+/// \return double - distance of the path, INFINITY if there is no path
+double ContractionHierarchy::query(unsigned int source, unsigned int target, std::vector<unsigned int>& path,
+                                  QueryContext& context){
+
+    path.clear();
+    context.start(numVertices, source, target);
+    if (source == target) {
+        path.push_back(source);
+        return 0;
+    }
+
+    QueryContext::Search& forwardSearch = context.forward;
+    QueryContext::Search& backwardSearch = context.backward;
+    unsigned int epoch = context.epoch;
+    forwardSearch.queue.push(source, 0);
+    backwardSearch.queue.push(target, 0);
+
+    double best = INFINITY;
+    unsigned int meet = NOT_IN_HEAP;
+
+    // Both searches only follow edges to higher ranked vertices, a shortest
+    // path always climbs to its highest ranked vertex and descends again,
+    // so it is found where the two searches meet. A search stops once its
+    // closest unsettled vertex is no closer than the best path found
+    while (true) {
+
+        bool forwardActive = !forwardSearch.queue.isEmpty() && forwardSearch.queue.topKey() < best;
+        bool backwardActive = !backwardSearch.queue.isEmpty() && backwardSearch.queue.topKey() < best;
+        if (!forwardActive && !backwardActive) break;
+
+        bool forward = forwardActive
+                       && (!backwardActive || forwardSearch.queue.topKey() <= backwardSearch.queue.topKey());
+        QueryContext::Search& search = forward ? forwardSearch : backwardSearch;
+        QueryContext::Search& other = forward ? backwardSearch : forwardSearch;
+
+        unsigned int u = search.queue.pop();
+        search.settled[u] = epoch;
+        double du = search.distance[u];
+
+        // Stall on demand, the edges of a vertex lead upwards but can also be
+        // walked down into it, if that reaches it by a shorter route its
+        // distance is not a shortest one and its edges need not be relaxed
+        bool stalled = false;
+        for (unsigned i = offsets[u]; i < offsets[u + 1] && !stalled; i++) {
+            unsigned int v = targets[i];
+            stalled = search.reached[v] == epoch && search.distance[v] + weights[i] < du;
+        }
+        if (stalled) continue;
+
+        for (unsigned i = offsets[u]; i < offsets[u + 1]; i++) {
+            unsigned int v = targets[i];
+            double dv = du + weights[i];
+
+            if (search.reached[v] != epoch || dv < search.distance[v]) {
+                search.reached[v] = epoch;
+                search.distance[v] = dv;
+                search.predecessor[v] = u;
+                search.queue.pushOrDecrease(v, dv);
+
+                if (other.reached[v] == epoch && dv + other.distance[v] < best) {
+                    best = dv + other.distance[v];
+                    meet = v;
+                }
+            }
+        }
+    }
+
+    if (best != INFINITY) {
+
+        // Unpack the upward path from the meeting vertex back to the source,
+        // reverse it, then unpack the path down from the meeting vertex. Each
+        // vertex's edge up to the next is held by the lower ranked of the two
+        unsigned int v = meet;
+        while (v != source) {
+            unsigned int u = forwardSearch.predecessor[v];
+            unpackEdge(v, u, findEdge(u, v), path);
+            v = u;
+        }
+        std::reverse(path.begin(), path.end());
+        path.push_back(meet);
+
+        v = meet;
+        while (v != target) {
+            unsigned int u = backwardSearch.predecessor[v];
+            unpackEdge(v, u, findEdge(u, v), path);
+            v = u;
+        }
+    }
+
+    return best;
+}
+
+/// \brief
+///
+/// Simple getter for the position of a vertex in the contraction order
+/// \param unsigned int - vertex's ID
+/// \return unsigned int - rank, 0 for the first contracted
+unsigned int ContractionHierarchy::getRank(unsigned int v){
+    return rank[v];
+}
+
+/// \brief
+///
+/// Simple getter for the number of shortcuts in the hierarchy built
+/// \return unsigned int - number of shortcuts
+unsigned int ContractionHierarchy::getNumShortcuts(){
+    return numShortcuts;
+}
+
+/// \brief
+///
+/// Finds the shortcuts needed to contract a vertex, by searching from
+/// each neighbour for a path to the other neighbours that is no longer
+/// than the path through the vertex and avoids it and the vertices
+/// being contracted alongside it
+/// \param unsigned int v - vertex to be contracted
+/// \param vector<vector<Arc> >& arcs - edges of the remaining graph
+/// \param vector<char>& blocked - vertices being contracted alongside
+/// \param WitnessSearch& search - working state of the calling thread
+/// \param vector<Shortcut>* shortcuts - collection the shortcuts are
+/// appended to, or NULL to only count them
+/// \return int - number of shortcuts needed
+int ContractionHierarchy::findShortcuts(unsigned int v, std::vector<std::vector<Arc> >& arcs, std::vector<char>& blocked,
+                                        WitnessSearch& search, std::vector<Shortcut>* shortcuts){
+
+    std::vector<Arc>& neighbours = arcs[v];
+    std::vector<double>& distance = search.distance;
+    unsigned int settleLimit = shortcuts == NULL ? SIMULATION_SETTLE_LIMIT : CONTRACTION_SETTLE_LIMIT;
+    int count = 0;
+
+    // Each pair of neighbours is checked once, from the earlier of the two
+    for (unsigned a = 0; a + 1 < neighbours.size(); a++) {
+
+        unsigned int u = neighbours[a].target;
+        double toV = neighbours[a].weight;
+
+        // A witness longer than the longest path through v is never needed
+        double limit = 0;
+        for (unsigned b = a + 1; b < neighbours.size(); b++) {
+            if (toV + neighbours[b].weight > limit) {
+                limit = toV + neighbours[b].weight;
+            }
+        }
+
+        // Mark the neighbours still to be reached, the search ends
+        // early once all of them have been settled
+        unsigned int unreached = neighbours.size() - a - 1;
+        for (unsigned b = a + 1; b < neighbours.size(); b++) {
+            search.isTarget[neighbours[b].target] = 1;
+        }
+
+        distance[u] = 0;
+        search.touched.push_back(u);
+        search.queue.push(u, 0);
+        unsigned int settled = 0;
+
+        while (!search.queue.isEmpty() && search.queue.topKey() <= limit
+               && settled < settleLimit) {
+
+            unsigned int x = search.queue.pop();
+            settled++;
+            if (search.isTarget[x] && --unreached == 0) break;
+
+            std::vector<Arc>& list = arcs[x];
+            for (unsigned i = 0; i < list.size(); i++) {
+                unsigned int y = list[i].target;
+                if (y == v || blocked[y]) continue;
+
+                double dy = distance[x] + list[i].weight;
+                if (dy <= limit && dy < distance[y]) {
+                    if (distance[y] == INFINITY) search.touched.push_back(y);
+                    distance[y] = dy;
+                    search.queue.pushOrDecrease(y, dy);
+                }
+            }
+        }
+
+        // A shortcut is needed wherever no witness as short was found
+        for (unsigned b = a + 1; b < neighbours.size(); b++) {
+            unsigned int w = neighbours[b].target;
+            search.isTarget[w] = 0;
+            double through = toV + neighbours[b].weight;
+            if (distance[w] > through) {
+                count++;
+                if (shortcuts != NULL) {
+                    Shortcut s;
+                    s.source = u;
+                    s.target = w;
+                    s.weight = through;
+                    s.middle = v;
+                    shortcuts->push_back(s);
+                }
+            }
+        }
+
+        for (unsigned i = 0; i < search.touched.size(); i++) {
+            distance[search.touched[i]] = INFINITY;
+        }
+        search.touched.clear();
+        search.queue.clear();
+    }
+
+    return count;
+}
+
+/// \brief
+///
+/// Adds an edge to a vertex's edges, or lowers the weight of
+/// its existing edge to the same vertex if the new one is shorter
+/// \param vector<Arc>& list - edges of the vertex
+/// \param Arc arc - edge to be added
+void ContractionHierarchy::mergeArc(std::vector<Arc>& list, Arc arc){
+
+    for (unsigned i = 0; i < list.size(); i++) {
+        if (list[i].target == arc.target) {
+            if (arc.weight < list[i].weight) {
+                list[i] = arc;
+            }
+            return;
+        }
+    }
+    list.push_back(arc);
+}
+
+/// \brief
+///
+/// Appends the original vertices along an edge or shortcut to a path
+/// collection, not including the vertex the edge is walked from
+/// \param unsigned int from - vertex the edge is walked from
+/// \param unsigned int to - vertex the edge is walked to
+/// \param unsigned int edge - index of the edge in the upward arrays
+/// \param vector<unsigned int>& path - collection the vertices are appended to
+void ContractionHierarchy::unpackEdge(unsigned int from, unsigned int to, unsigned int edge, std::vector<unsigned int>& path){
+
+    // A shortcut stands for the two edges joining its end points to the
+    // contracted middle vertex, both held by that vertex since it was
+    // contracted first. Segments are unpacked from a stack, the first
+    // half above the second, so the vertices come out in walking order
+    struct Segment {
+        unsigned int from;
+        unsigned int to;
+        unsigned int edge;
+    };
+
+    std::vector<Segment> pending;
+    Segment whole = { from, to, edge };
+    pending.push_back(whole);
+
+    while (!pending.empty()) {
+        Segment s = pending.back();
+        pending.pop_back();
+
+        unsigned int middle = middles[s.edge];
+        if (middle == NOT_IN_HEAP) {
+            path.push_back(s.to);
+            continue;
+        }
+
+        // The edge is held by the end point it does not lead to,
+        // which tells which half joins the vertex walked from
+        bool fromOwner = targets[s.edge] == s.to;
+        unsigned int fromHalf = fromOwner ? ownerHalf[s.edge] : targetHalf[s.edge];
+        unsigned int toHalf = fromOwner ? targetHalf[s.edge] : ownerHalf[s.edge];
+
+        Segment second = { middle, s.to, toHalf };
+        Segment first = { s.from, middle, fromHalf };
+        pending.push_back(second);
+        pending.push_back(first);
+    }
+}
+
+/// \brief
+///
+/// Finds the upward edge of a vertex leading to another vertex,
+/// used to link shortcuts to the edges they stand for and to
+/// walk a path found by a query back down
+/// \param unsigned int from - lower ranked vertex holding the edge
+/// \param unsigned int to - vertex the edge leads to
+/// \return unsigned int - index of the edge in the upward arrays
+unsigned int ContractionHierarchy::findEdge(unsigned int from, unsigned int to){
+    unsigned int i = offsets[from];
+    while (targets[i] != to) {
+        i++;
+    }
+    return i;
+}
@@ -0,0 +1,178 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: contractionhierarchy.h
+/// Header of ContractionHierarchy class
+/// Encapsulates a contraction hierarchy built from a graph,
+/// preprocessed once so that point to point shortest path
+/// queries only search upwards through a small part of it
+
+#ifndef _contractionhierarchy_h
+#define _contractionhierarchy_h
+
+#include <vector>
+
+#include "graph.h"
+#include "indexedheap.h"
+#include "querycontext.h"
+
+/// Encapsulates a contraction hierarchy. Preprocessing removes (contracts)
+/// the vertices one by one in order of edge difference, the number of
+/// shortcuts contracting a vertex would add less the edges it removes,
+/// adding a shortcut between two neighbours wherever the path through the
+/// contracted vertex is the only shortest one. Independent sets of vertices
+/// are contracted together across threads. Every edge and shortcut is kept
+/// with the endpoint contracted first, so a query runs Dijkstra's algorithm
+/// upwards from both ends and shortcuts are unpacked into original edges.
+/// The working state of each query is kept in a query context, so once built
+/// any number of threads can query the hierarchy at once, each with its own
+class ContractionHierarchy {
+
+    public:
+
+        /// \brief
+        ///
+        /// Constructor, initializes an empty hierarchy
+        ContractionHierarchy();
+
+        /// \brief
+        ///
+        /// Destructor, no objects dynamically created from this class
+        ~ContractionHierarchy();
+
+        /// \brief
+        ///
+        /// Builds the hierarchy from the edges of a graph, replacing any
+        /// hierarchy built before
+        /// \param Graph& graph - graph to be preprocessed
+        /// \param unsigned int numThreads - number of threads to use,
+        /// 0 for one per hardware thread
+        void build(Graph& graph, unsigned int numThreads);
+
+        /// \brief
+        ///
+        /// Calculates the minimum distance and path between two vertices
+        /// \pre - hierarchy built
+        /// \param unsigned int source - source vertex's ID
+        /// \param unsigned int target - target vertex's ID
+        /// \param vector<unsigned int>& path - filled with the vertex IDs
+        /// from source to target, left empty if there is no path
+        /// \return double - distance of the path, INFINITY if there is no path
+        double query(unsigned int source, unsigned int target, std::vector<unsigned int>& path);
+
+        /// \brief
+        ///
+        /// Calculates the minimum distance and path between two vertices
+        /// \pre - hierarchy built
+        /// \param unsigned int source - source vertex's ID
+        /// \param unsigned int target - target vertex's ID
+        /// \param vector<unsigned int>& path - filled with the vertex IDs
+        /// from source to target, left empty if there is no path
+        /// \param QueryContext& context - context holding the working state of the search
+        /// \return double - distance of the path, INFINITY if there is no path
+        double query(unsigned int source, unsigned int target, std::vector<unsigned int>& path,
+                     QueryContext& context);
+
+        /// \brief
+        ///
+        /// Simple getter for the position of a vertex in the contraction order
+        /// \param unsigned int - vertex's ID
+        /// \return unsigned int - rank, 0 for the first contracted
+        unsigned int getRank(unsigned int);
+
+        /// \brief
+        ///
+        /// Simple getter for the number of shortcuts in the hierarchy built
+        /// \return unsigned int - number of shortcuts
+        unsigned int getNumShortcuts();
+
+    private:
+
+        // Edge of the graph being contracted, the vertex contracted to
+        // create it is NOT_IN_HEAP for edges of the original graph
+        struct Arc {
+            unsigned int target;
+            double weight;
+            unsigned int middle;
+        };
+
+        // Shortcut found to be needed while contracting a vertex
+        struct Shortcut {
+            unsigned int source;
+            unsigned int target;
+            double weight;
+            unsigned int middle;
+        };
+
+        // Working state of the witness searches run by one thread
+        struct WitnessSearch {
+            std::vector<double> distance;
+            std::vector<char> isTarget;
+            std::vector<unsigned int> touched;
+            IndexedHeap queue;
+        };
+
+        // Instance variables storing the number of vertices, their ranks,
+        // the number of shortcuts and the upward edges of each vertex in
+        // compressed sparse row form, with the contracted middle vertex of
+        // each shortcut and the indices of the two edges it stands for
+        unsigned int numVertices;
+        unsigned int numShortcuts;
+        std::vector<unsigned int> rank;
+        std::vector<unsigned int> offsets;
+        std::vector<unsigned int> targets;
+        std::vector<double> weights;
+        std::vector<unsigned int> middles;
+        std::vector<unsigned int> ownerHalf;
+        std::vector<unsigned int> targetHalf;
+
+        // Instance variable holding the working state of
+        // queries called without a context of their own
+        QueryContext context;
+
+        /// \brief
+        ///
+        /// Finds the shortcuts needed to contract a vertex, by searching from
+        /// each neighbour for a path to the other neighbours that is no longer
+        /// than the path through the vertex and avoids it and the vertices
+        /// being contracted alongside it
+        /// \param unsigned int v - vertex to be contracted
+        /// \param vector<vector<Arc> >& arcs - edges of the remaining graph
+        /// \param vector<char>& blocked - vertices being contracted alongside
+        /// \param WitnessSearch& search - working state of the calling thread
+        /// \param vector<Shortcut>* shortcuts - collection the shortcuts are
+        /// appended to, or NULL to only count them
+        /// \return int - number of shortcuts needed
+        int findShortcuts(unsigned int v, std::vector<std::vector<Arc> >& arcs, std::vector<char>& blocked,
+                          WitnessSearch& search, std::vector<Shortcut>* shortcuts);
+
+        /// \brief
+        ///
+        /// Adds an edge to a vertex's edges, or lowers the weight of
+        /// its existing edge to the same vertex if the new one is shorter
+        /// \param vector<Arc>& list - edges of the vertex
+        /// \param Arc arc - edge to be added
+        void mergeArc(std::vector<Arc>& list, Arc arc);
+
+        /// \brief
+        ///
+        /// Appends the original vertices along an edge or shortcut to a path
+        /// collection, not including the vertex the edge is walked from
+        /// \param unsigned int from - vertex the edge is walked from
+        /// \param unsigned int to - vertex the edge is walked to
+        /// \param unsigned int edge - index of the edge in the upward arrays
+        /// \param vector<unsigned int>& path - collection the vertices are appended to
+        void unpackEdge(unsigned int from, unsigned int to, unsigned int edge, std::vector<unsigned int>& path);
+
+        /// \brief
+        ///
+        /// Finds the upward edge of a vertex leading to another vertex,
+        /// used to link shortcuts to the edges they stand for and to
+        /// walk a path found by a query back down
+        /// \param unsigned int from - lower ranked vertex holding the edge
+        /// \param unsigned int to - vertex the edge leads to
+        /// \return unsigned int - index of the edge in the upward arrays
+        unsigned int findEdge(unsigned int from, unsigned int to);
+
+};
+
+#endif // _contractionhierarchy_h
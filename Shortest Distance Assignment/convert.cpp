@@ -0,0 +1,47 @@
+/// File:  convert.cpp
+///
+/// Driver program converting a graph text file to a binary graph file.
+///
+/// The text file is in either format read by roads: the number of cities, the
+/// co-ordinates of every city, then either one flag for every pair of cities
+/// or one line for every edge, see textgraphreader.h. Edges are listed in the
+/// binary file in the order roads adds them, so both pick the same tree.
+///
+/// The binary file can be given to roads in place of the text file, and is
+/// mapped into memory rather than read, see graphfile.h for its layout.
+///
+
+#include <iostream>
+#include <vector>
+
+#include "graphfile.h"
+#include "textgraphreader.h"
+
+using namespace std;
+
+int main(int argc, char *argv[]) {
+
+   if (argc != 3) {
+      cerr << "Usage: " << argv[0] << " <text file> <graph file>" << endl;
+      return 1;
+   }
+
+   // read the whole file and check it exists and is complete,
+   // the edges are parsed across one thread per hardware thread
+   TextGraphReader textFile;
+   if (!textFile.read(argv[1], 0)) {
+      cerr <<  "Error: Could not read file" << endl;
+      return 1;
+   }
+
+   const vector<WeightedEdge>& edges = textFile.getEdges();
+   unsigned int numCities = textFile.getNumVertices();
+
+   if (!GraphFile::write(argv[2], numCities, textFile.getCoordinates().data(), edges)) {
+      cerr << "Error: Could not write file" << endl;
+      return 1;
+   }
+
+   cout << numCities << " cities and " << edges.size() << " edges written" << endl;
+   return 0;
+}
@@ -0,0 +1,391 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: delaunay.cpp
+/// Implementation of Delaunay class
+/// Encapsulates the Delaunay triangulation of a set of points in
+/// 2D space, computed by divide and conquer in O(N log N) time
+
+#include <algorithm>
+#include <cmath>
+
+#include "delaunay.h"
+#include "expansion.h"
+
+// Constant marking the origin of a dual edge, which is a face rather than a point
+const unsigned int NOT_A_POINT = 0xFFFFFFFF;
+
+// Constants bounding the rounding error of the orientation and in circle
+// tests evaluated in floating point, relative to the magnitudes of their
+// terms (Shewchuk), within which the sign is found exactly instead
+const double EPSILON = 1.1102230246251565e-16;
+const double ORIENTATION_ERROR = (3 + 16 * EPSILON) * EPSILON;
+const double IN_CIRCLE_ERROR = (10 + 96 * EPSILON) * EPSILON;
+
+/// Encapsulates the Delaunay triangulation of points in 2D space using
+/// the divide and conquer algorithm of Guibas and Stolfi. The triangulation
+/// is held in a quad-edge structure, each undirected edge is a group of four
+/// directed edges (the edge, its dual, and their reverses) stored by index.
+/// The Euclidean minimum spanning tree of the points is a subgraph of the
+/// triangulation, which has at most 3N edges
+
+/// \brief
+///
+/// Constructor, initializes an empty triangulation
+Delaunay::Delaunay(){
+    xy = NULL;
+}
+
+/// \brief
+///
+/// Destructor, no objects dynamically created from this class
+Delaunay::~Delaunay(){
+}
+
+/// \brief
+///
+/// Triangulates a set of points and appends every edge of the
+/// triangulation once, weighted by its Euclidean length. Points at the
+/// same location are joined to the first of them by an edge of weight 0
+/// \param const double* xy - x and y coordinates of each point in pairs
+/// \param unsigned int numPoints - number of points
+/// \param vector<WeightedEdge>& edges - collection the edges are appended to
+void Delaunay::triangulate(const double* xy, unsigned int numPoints, std::vector<WeightedEdge>& edges){
+
+    this->xy = xy;
+    origin.clear();
+    next.clear();
+    deleted.clear();
+
+    // Sort the points by x then y, stable so the first of any
+    // duplicates is kept and the rest are joined to it
+    std::vector<unsigned int> order(numPoints);
+    for (unsigned i = 0; i < numPoints; i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [xy](unsigned int a, unsigned int b) {
+        if (xy[2 * a] != xy[2 * b]) return xy[2 * a] < xy[2 * b];
+        return xy[2 * a + 1] < xy[2 * b + 1];
+    });
+
+    sorted.clear();
+    for (unsigned i = 0; i < numPoints; i++) {
+        unsigned int p = order[i];
+        if (!sorted.empty()) {
+            unsigned int q = sorted.back();
+            if (xy[2 * p] == xy[2 * q] && xy[2 * p + 1] == xy[2 * q + 1]) {
+                WeightedEdge e;
+                e.source = q;
+                e.destination = p;
+                e.weight = 0;
+                edges.push_back(e);
+                continue;
+            }
+        }
+        sorted.push_back(p);
+    }
+
+    if (sorted.size() < 2) return;
+
+    // A triangulation of N points has at most 3N - 6 edges, and
+    // fewer than that again are created and later deleted
+    origin.reserve(4 * 6 * sorted.size());
+    next.reserve(4 * 6 * sorted.size());
+    deleted.reserve(6 * sorted.size());
+
+    unsigned int left, right;
+    build(0, sorted.size() - 1, left, right);
+
+    // Every group of four that survived holds one undirected edge
+    for (unsigned int group = 0; group < deleted.size(); group++) {
+        if (deleted[group]) continue;
+        unsigned int a = origin[4 * group];
+        unsigned int b = origin[4 * group + 2];
+        double dx = xy[2 * a] - xy[2 * b];
+        double dy = xy[2 * a + 1] - xy[2 * b + 1];
+        WeightedEdge e;
+        e.source = a < b ? a : b;
+        e.destination = a < b ? b : a;
+        e.weight = sqrt(dx * dx + dy * dy);
+        edges.push_back(e);
+    }
+}
+
+/// \brief
+///
+/// Triangulates the sorted points in the index range [low, high]
+/// \param unsigned int low - first index
+/// \param unsigned int high - last index
+/// \param unsigned int& left - set to the counterclockwise convex hull
+/// edge out of the leftmost point
+/// \param unsigned int& right - set to the clockwise convex hull edge
+/// out of the rightmost point
+void Delaunay::build(unsigned int low, unsigned int high, unsigned int& left, unsigned int& right){
+
+    // Two points, a single edge
+    if (high - low == 1) {
+        left = makeEdge(sorted[low], sorted[high]);
+        right = sym(left);
+        return;
+    }
+
+    // Three points, two edges and a third if they are not collinear
+    if (high - low == 2) {
+        unsigned int a = makeEdge(sorted[low], sorted[low + 1]);
+        unsigned int b = makeEdge(sorted[low + 1], sorted[high]);
+        splice(sym(a), b);
+        double turn = cross(sorted[low], sorted[low + 1], sorted[high]);
+        if (turn == 0) {
+            left = a;
+            right = sym(b);
+            return;
+        }
+        unsigned int c = connect(b, a);
+        if (turn > 0) {
+            left = a;
+            right = sym(b);
+        } else {
+            left = sym(c);
+            right = c;
+        }
+        return;
+    }
+
+    // Triangulate each half, the innermost hull edges facing each other
+    unsigned int mid = (low + high) / 2;
+    unsigned int leftOuter, leftInner, rightInner, rightOuter;
+    build(low, mid, leftOuter, leftInner);
+    build(mid + 1, high, rightInner, rightOuter);
+
+    // Walk the inner hull edges down to the lower common tangent
+    while (true) {
+        if (leftOf(origin[rightInner], leftInner)) {
+            leftInner = lnext(leftInner);
+        } else if (rightOf(origin[leftInner], rightInner)) {
+            rightInner = next[sym(rightInner)];
+        } else {
+            break;
+        }
+    }
+
+    // The base edge joins the halves along the tangent
+    unsigned int base = connect(sym(rightInner), leftInner);
+    if (origin[leftInner] == origin[leftOuter]) leftOuter = sym(base);
+    if (origin[rightInner] == origin[rightOuter]) rightOuter = base;
+
+    // Zip the halves together from the bottom up, each step adding the
+    // edge from the base to the candidate whose circle holds no other
+    // candidate, after deleting the edges that fail the circle test
+    while (true) {
+
+        unsigned int leftCandidate = next[sym(base)];
+        bool leftValid = rightOf(destination(leftCandidate), base);
+        if (leftValid) {
+            while (inCircle(destination(base), origin[base], destination(leftCandidate),
+                            destination(next[leftCandidate]))) {
+                unsigned int t = next[leftCandidate];
+                deleteEdge(leftCandidate);
+                leftCandidate = t;
+            }
+        }
+
+        unsigned int rightCandidate = oprev(base);
+        bool rightValid = rightOf(destination(rightCandidate), base);
+        if (rightValid) {
+            while (inCircle(destination(base), origin[base], destination(rightCandidate),
+                            destination(oprev(rightCandidate)))) {
+                unsigned int t = oprev(rightCandidate);
+                deleteEdge(rightCandidate);
+                rightCandidate = t;
+            }
+        }
+
+        // Both candidates below the base means it is the upper tangent
+        leftValid = rightOf(destination(leftCandidate), base);
+        rightValid = rightOf(destination(rightCandidate), base);
+        if (!leftValid && !rightValid) break;
+
+        if (!leftValid || (rightValid && inCircle(destination(leftCandidate), origin[leftCandidate],
+                                                  origin[rightCandidate], destination(rightCandidate)))) {
+            base = connect(rightCandidate, sym(base));
+        } else {
+            base = connect(sym(base), sym(leftCandidate));
+        }
+    }
+
+    left = leftOuter;
+    right = rightOuter;
+}
+
+/// \brief
+///
+/// Creates an isolated edge between two points
+/// \param unsigned int a - origin point
+/// \param unsigned int b - destination point
+/// \return unsigned int - the directed edge from a to b
+unsigned int Delaunay::makeEdge(unsigned int a, unsigned int b){
+
+    // The group holds the edge, its dual, the reverse and the
+    // reverse dual, the dual edges have no origin point
+    unsigned int e = origin.size();
+    origin.push_back(a);
+    origin.push_back(NOT_A_POINT);
+    origin.push_back(b);
+    origin.push_back(NOT_A_POINT);
+    next.push_back(e);
+    next.push_back(e + 3);
+    next.push_back(e + 2);
+    next.push_back(e + 1);
+    deleted.push_back(0);
+    return e;
+}
+
+/// \brief
+///
+/// Joins or separates the edge rings around the origins of two edges
+/// \param unsigned int a - first edge
+/// \param unsigned int b - second edge
+void Delaunay::splice(unsigned int a, unsigned int b){
+    unsigned int alpha = rot(next[a]);
+    unsigned int beta = rot(next[b]);
+    std::swap(next[alpha], next[beta]);
+    std::swap(next[a], next[b]);
+}
+
+/// \brief
+///
+/// Adds an edge from the destination of one edge to the origin of
+/// another, keeping all three with the same left face
+/// \param unsigned int a - first edge
+/// \param unsigned int b - second edge
+/// \return unsigned int - the new edge
+unsigned int Delaunay::connect(unsigned int a, unsigned int b){
+    unsigned int e = makeEdge(destination(a), origin[b]);
+    splice(e, lnext(a));
+    splice(sym(e), b);
+    return e;
+}
+
+/// \brief
+///
+/// Removes an edge from the triangulation
+/// \param unsigned int - edge to be removed
+void Delaunay::deleteEdge(unsigned int e){
+    splice(e, oprev(e));
+    splice(sym(e), oprev(sym(e)));
+    deleted[e / 4] = 1;
+}
+
+/// \brief
+///
+/// Navigation helpers of the quad-edge structure, the dual edge,
+/// the reversed edge, the inverse dual, the destination point, the
+/// previous edge around the origin and the next around the left face
+unsigned int Delaunay::rot(unsigned int e){
+    return (e & ~3u) | ((e + 1) & 3u);
+}
+
+unsigned int Delaunay::sym(unsigned int e){
+    return (e & ~3u) | ((e + 2) & 3u);
+}
+
+unsigned int Delaunay::rotInverse(unsigned int e){
+    return (e & ~3u) | ((e + 3) & 3u);
+}
+
+unsigned int Delaunay::destination(unsigned int e){
+    return origin[sym(e)];
+}
+
+unsigned int Delaunay::oprev(unsigned int e){
+    return rot(next[rot(e)]);
+}
+
+unsigned int Delaunay::lnext(unsigned int e){
+    return rot(next[rotInverse(e)]);
+}
+
+/// \brief
+///
+/// Twice the signed area of the triangle p, a, b, its sign exact
+/// even where rounding could decide it, for nearly collinear points
+/// \return double - positive if the points turn counterclockwise
+double Delaunay::cross(unsigned int p, unsigned int a, unsigned int b){
+    double ax = xy[2 * a] - xy[2 * p];
+    double ay = xy[2 * a + 1] - xy[2 * p + 1];
+    double bx = xy[2 * b] - xy[2 * p];
+    double by = xy[2 * b + 1] - xy[2 * p + 1];
+    double left = ax * by;
+    double right = ay * bx;
+    double det = left - right;
+
+    // Terms of opposite signs, or a zero one, leave the sign exact
+    if ((left > 0) != (right > 0) || left == 0 || right == 0) return det;
+    if (std::fabs(det) > ORIENTATION_ERROR * (std::fabs(left) + std::fabs(right))) {
+        return det;
+    }
+
+    // Too close to call, evaluated again from the coordinates exactly
+    Expansion px(xy[2 * p]), py(xy[2 * p + 1]);
+    Expansion exactAx = Expansion(xy[2 * a]).difference(px);
+    Expansion exactAy = Expansion(xy[2 * a + 1]).difference(py);
+    Expansion exactBx = Expansion(xy[2 * b]).difference(px);
+    Expansion exactBy = Expansion(xy[2 * b + 1]).difference(py);
+    return exactAx.product(exactBy).difference(exactAy.product(exactBx)).sign();
+}
+
+/// \brief
+///
+/// Checks whether a point lies strictly to the left or right of an edge
+/// \param unsigned int p - point
+/// \param unsigned int e - edge
+/// \return bool - true if the point is on that side
+bool Delaunay::leftOf(unsigned int p, unsigned int e){
+    return cross(p, origin[e], destination(e)) > 0;
+}
+
+bool Delaunay::rightOf(unsigned int p, unsigned int e){
+    return cross(p, origin[e], destination(e)) < 0;
+}
+
+/// \brief
+///
+/// Checks whether point d lies strictly inside the circle through
+/// the counterclockwise points a, b and c, exactly even for
+/// nearly cocircular points
+/// \return bool - true if inside
+bool Delaunay::inCircle(unsigned int a, unsigned int b, unsigned int c, unsigned int d){
+
+    // Lift the points onto a paraboloid relative to d, d is inside the
+    // circle when the lifted a, b, c turn counterclockwise seen from above
+    double ax = xy[2 * a] - xy[2 * d], ay = xy[2 * a + 1] - xy[2 * d + 1];
+    double bx = xy[2 * b] - xy[2 * d], by = xy[2 * b + 1] - xy[2 * d + 1];
+    double cx = xy[2 * c] - xy[2 * d], cy = xy[2 * c + 1] - xy[2 * d + 1];
+    double a2 = ax * ax + ay * ay;
+    double b2 = bx * bx + by * by;
+    double c2 = cx * cx + cy * cy;
+    double bxcy = bx * cy, cxby = cx * by;
+    double cxay = cx * ay, axcy = ax * cy;
+    double axby = ax * by, bxay = bx * ay;
+    double det = a2 * (bxcy - cxby) + b2 * (cxay - axcy) + c2 * (axby - bxay);
+    double permanent = (std::fabs(bxcy) + std::fabs(cxby)) * a2
+                     + (std::fabs(cxay) + std::fabs(axcy)) * b2
+                     + (std::fabs(axby) + std::fabs(bxay)) * c2;
+    if (std::fabs(det) > IN_CIRCLE_ERROR * permanent || permanent == 0) {
+        return det > 0;
+    }
+
+    // Too close to call, as for nearly cocircular points,
+    // evaluated again from the coordinates exactly
+    Expansion dx(xy[2 * d]), dy(xy[2 * d + 1]);
+    Expansion exactAx = Expansion(xy[2 * a]).difference(dx);
+    Expansion exactAy = Expansion(xy[2 * a + 1]).difference(dy);
+    Expansion exactBx = Expansion(xy[2 * b]).difference(dx);
+    Expansion exactBy = Expansion(xy[2 * b + 1]).difference(dy);
+    Expansion exactCx = Expansion(xy[2 * c]).difference(dx);
+    Expansion exactCy = Expansion(xy[2 * c + 1]).difference(dy);
+    Expansion liftA = exactAx.product(exactAx).sum(exactAy.product(exactAy));
+    Expansion liftB = exactBx.product(exactBx).sum(exactBy.product(exactBy));
+    Expansion liftC = exactCx.product(exactCx).sum(exactCy.product(exactCy));
+    Expansion exactDet = liftA.product(exactBx.product(exactCy).difference(exactCx.product(exactBy)))
+                         .sum(liftB.product(exactCx.product(exactAy).difference(exactAx.product(exactCy))))
+                         .sum(liftC.product(exactAx.product(exactBy).difference(exactBx.product(exactAy))));
+    return exactDet.sign() > 0;
+}
@@ -0,0 +1,136 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: delaunay.h
+/// Header of Delaunay class
+/// Encapsulates the Delaunay triangulation of a set of points in
+/// 2D space, computed by divide and conquer in O(N log N) time
+
+#ifndef _delaunay_h
+#define _delaunay_h
+
+#include <vector>
+
+#include "edge.h"
+
+/// Encapsulates the Delaunay triangulation of points in 2D space using
+/// the divide and conquer algorithm of Guibas and Stolfi. The triangulation
+/// is held in a quad-edge structure, each undirected edge is a group of four
+/// directed edges (the edge, its dual, and their reverses) stored by index.
+/// The Euclidean minimum spanning tree of the points is a subgraph of the
+/// triangulation, which has at most 3N edges
+class Delaunay {
+
+    public:
+
+        /// \brief
+        ///
+        /// Constructor, initializes an empty triangulation
+        Delaunay();
+
+        /// \brief
+        ///
+        /// Destructor, no objects dynamically created from this class
+        ~Delaunay();
+
+        /// \brief
+        ///
+        /// Triangulates a set of points and appends every edge of the
+        /// triangulation once, weighted by its Euclidean length. Points at the
+        /// same location are joined to the first of them by an edge of weight 0
+        /// \param const double* xy - x and y coordinates of each point in pairs
+        /// \param unsigned int numPoints - number of points
+        /// \param vector<WeightedEdge>& edges - collection the edges are appended to
+        void triangulate(const double* xy, unsigned int numPoints, std::vector<WeightedEdge>& edges);
+
+    private:
+
+        // Instance variables storing the coordinates being triangulated, the
+        // points sorted by x then y, and for each directed edge its origin
+        // point and the next edge counterclockwise around that origin, with
+        // whether each group of four has been deleted
+        const double* xy;
+        std::vector<unsigned int> sorted;
+        std::vector<unsigned int> origin;
+        std::vector<unsigned int> next;
+        std::vector<char> deleted;
+
+        /// \brief
+        ///
+        /// Triangulates the sorted points in the index range [low, high]
+        /// \param unsigned int low - first index
+        /// \param unsigned int high - last index
+        /// \param unsigned int& left - set to the counterclockwise convex hull
+        /// edge out of the leftmost point
+        /// \param unsigned int& right - set to the clockwise convex hull edge
+        /// out of the rightmost point
+        void build(unsigned int low, unsigned int high, unsigned int& left, unsigned int& right);
+
+        /// \brief
+        ///
+        /// Creates an isolated edge between two points
+        /// \param unsigned int a - origin point
+        /// \param unsigned int b - destination point
+        /// \return unsigned int - the directed edge from a to b
+        unsigned int makeEdge(unsigned int a, unsigned int b);
+
+        /// \brief
+        ///
+        /// Joins or separates the edge rings around the origins of two edges
+        /// \param unsigned int a - first edge
+        /// \param unsigned int b - second edge
+        void splice(unsigned int a, unsigned int b);
+
+        /// \brief
+        ///
+        /// Adds an edge from the destination of one edge to the origin of
+        /// another, keeping all three with the same left face
+        /// \param unsigned int a - first edge
+        /// \param unsigned int b - second edge
+        /// \return unsigned int - the new edge
+        unsigned int connect(unsigned int a, unsigned int b);
+
+        /// \brief
+        ///
+        /// Removes an edge from the triangulation
+        /// \param unsigned int - edge to be removed
+        void deleteEdge(unsigned int);
+
+        /// \brief
+        ///
+        /// Navigation helpers of the quad-edge structure, the dual edge,
+        /// the reversed edge, the inverse dual, the destination point, the
+        /// previous edge around the origin and the next around the left face
+        unsigned int rot(unsigned int);
+        unsigned int sym(unsigned int);
+        unsigned int rotInverse(unsigned int);
+        unsigned int destination(unsigned int);
+        unsigned int oprev(unsigned int);
+        unsigned int lnext(unsigned int);
+
+        /// \brief
+        ///
+        /// Twice the signed area of the triangle p, a, b, its sign exact
+        /// even where rounding could decide it, for nearly collinear points
+        /// \return double - positive if the points turn counterclockwise
+        double cross(unsigned int p, unsigned int a, unsigned int b);
+
+        /// \brief
+        ///
+        /// Checks whether a point lies strictly to the left or right of an edge
+        /// \param unsigned int p - point
+        /// \param unsigned int e - edge
+        /// \return bool - true if the point is on that side
+        bool leftOf(unsigned int p, unsigned int e);
+        bool rightOf(unsigned int p, unsigned int e);
+
+        /// \brief
+        ///
+        /// Checks whether point d lies strictly inside the circle through
+        /// the counterclockwise points a, b and c, exactly even for
+        /// nearly cocircular points
+        /// \return bool - true if inside
+        bool inCircle(unsigned int a, unsigned int b, unsigned int c, unsigned int d);
+
+};
+
+#endif // _delaunay_h
@@ -6,6 +6,7 @@
 /// disjoint set data structure
 
 #include "disjointset.h"
+#include "graphstats.h"
 
 /// Encapsulates methods to implement a
 /// disjoint set data structure, including union-find algorithms
@@ -43,7 +44,10 @@ DisjointSet::~DisjointSet(){
 /// \return int - subset
 int DisjointSet::find(int i){
 
+    GRAPH_STATS_COUNT(FINDS, 1);
     while (i != id[i]) {
+        GRAPH_STATS_COUNT(FIND_PATH_LENGTH, 1);
+        GRAPH_STATS_COUNT(COMPRESSION_WRITES, id[i] != id[id[i]]);
         id[i] = id[id[i]]; // make elements point to their grandparent
         i = id[i];
     }
@@ -76,8 +76,8 @@ bool Edge::operator() (Edge* first, Edge* second){
 /// \param edge - reference to edge
 /// \return ostream& - output string representation of edge
 std::ostream& operator<<(std::ostream& out, Edge& edge) {
-    out << "E:" << edge.source->getPredecessorId()
+    out << "E:" << edge.getSource()->getId()
     << "--[" << edge.getWeight() << "]-->"
-    << edge.getDestination();
+    << edge.getDestination()->getId();
     return out;
 }
@@ -86,4 +86,13 @@ class Edge {
         double weight;
 };
 
+/// Plain record of an undirected edge by vertex identifiers,
+/// used where edges are stored in bulk in contiguous arrays
+/// rather than as individually allocated Edge objects
+struct WeightedEdge {
+    unsigned int source;
+    unsigned int destination;
+    double weight;
+};
+
 #endif // _edge_h
@@ -0,0 +1,133 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: expansion.cpp
+/// Implementation of Expansion class
+/// Encapsulates a real number held exactly as a sum of doubles,
+/// so sums, differences and products of doubles carry no rounding
+
+#include <cmath>
+
+#include "expansion.h"
+
+/// Encapsulates a real number as an expansion (Shewchuk), a sum of
+/// doubles in increasing order of magnitude that do not overlap, whose
+/// largest component has the sign of the whole. Sums, differences and
+/// products of expansions are exact as long as nothing overflows or
+/// underflows, at a cost growing with the number of components, so
+/// they decide geometric tests only where floating point cannot
+
+/// \brief
+///
+/// Constructor, initializes the expansion to zero
+Expansion::Expansion(){
+}
+
+/// \brief
+///
+/// Constructor, initializes the expansion to a double
+/// \param double value - value held
+Expansion::Expansion(double value){
+    if (value != 0) {
+        components.push_back(value);
+    }
+}
+
+/// \brief
+///
+/// Destructor, no objects dynamically created from this class
+Expansion::~Expansion(){
+}
+
+/// \brief
+///
+/// Calculates the exact sum of this expansion and another
+/// \param const Expansion& other - expansion added
+/// \return Expansion - the sum
+Expansion Expansion::sum(const Expansion& other){
+    Expansion result = *this;
+    for (unsigned int i = 0; i < other.components.size(); i++) {
+        result.grow(other.components[i]);
+    }
+    return result;
+}
+
+/// \brief
+///
+/// Calculates the exact difference of this expansion and another
+/// \param const Expansion& other - expansion subtracted
+/// \return Expansion - the difference
+Expansion Expansion::difference(const Expansion& other){
+    Expansion result = *this;
+    for (unsigned int i = 0; i < other.components.size(); i++) {
+        result.grow(-other.components[i]);
+    }
+    return result;
+}
+
+/// \brief
+///
+/// Calculates the exact product of this expansion and another
+/// \param const Expansion& other - expansion multiplied by
+/// \return Expansion - the product
+Expansion Expansion::product(const Expansion& other){
+    Expansion result;
+    for (unsigned int i = 0; i < other.components.size(); i++) {
+        result = result.sum(scale(other.components[i]));
+    }
+    return result;
+}
+
+/// \brief
+///
+/// Finds the sign of the number held
+/// \return int - 1 if positive, -1 if negative, 0 if zero
+int Expansion::sign(){
+    if (components.empty()) return 0;
+    return components.back() > 0 ? 1 : -1;
+}
+
+/// \brief
+///
+/// Adds a double to the expansion in place
+/// \param double b - value added
+void Expansion::grow(double b){
+
+    // Carry the value up through the components, each sum split into
+    // its rounded value and the exact error left behind (Knuth's two-sum)
+    unsigned int kept = 0;
+    double carry = b;
+    for (unsigned int i = 0; i < components.size(); i++) {
+        double e = components[i];
+        double x = carry + e;
+        double bVirtual = x - carry;
+        double aVirtual = x - bVirtual;
+        double error = (carry - aVirtual) + (e - bVirtual);
+        if (error != 0) {
+            components[kept++] = error;
+        }
+        carry = x;
+    }
+    components.resize(kept);
+    if (carry != 0) {
+        components.push_back(carry);
+    }
+}
+
+/// \brief
+///
+/// Calculates the exact product of this expansion and a double
+/// \param double b - value multiplied by
+/// \return Expansion - the product
+Expansion Expansion::scale(double b){
+
+    // Each component's product is split into its rounded value and
+    // the exact error, found with a fused multiply-add, then summed
+    Expansion result;
+    for (unsigned int i = 0; i < components.size(); i++) {
+        double p = components[i] * b;
+        double error = std::fma(components[i], b, -p);
+        if (error != 0) result.grow(error);
+        if (p != 0) result.grow(p);
+    }
+    return result;
+}
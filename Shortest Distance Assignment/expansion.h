@@ -0,0 +1,87 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: expansion.h
+/// Header of Expansion class
+/// Encapsulates a real number held exactly as a sum of doubles,
+/// so sums, differences and products of doubles carry no rounding
+
+#ifndef _expansion_h
+#define _expansion_h
+
+#include <vector>
+
+/// Encapsulates a real number as an expansion (Shewchuk), a sum of
+/// doubles in increasing order of magnitude that do not overlap, whose
+/// largest component has the sign of the whole. Sums, differences and
+/// products of expansions are exact as long as nothing overflows or
+/// underflows, at a cost growing with the number of components, so
+/// they decide geometric tests only where floating point cannot
+class Expansion {
+
+    public:
+
+        /// \brief
+        ///
+        /// Constructor, initializes the expansion to zero
+        Expansion();
+
+        /// \brief
+        ///
+        /// Constructor, initializes the expansion to a double
+        /// \param double value - value held
+        Expansion(double value);
+
+        /// \brief
+        ///
+        /// Destructor, no objects dynamically created from this class
+        ~Expansion();
+
+        /// \brief
+        ///
+        /// Calculates the exact sum of this expansion and another
+        /// \param const Expansion& other - expansion added
+        /// \return Expansion - the sum
+        Expansion sum(const Expansion& other);
+
+        /// \brief
+        ///
+        /// Calculates the exact difference of this expansion and another
+        /// \param const Expansion& other - expansion subtracted
+        /// \return Expansion - the difference
+        Expansion difference(const Expansion& other);
+
+        /// \brief
+        ///
+        /// Calculates the exact product of this expansion and another
+        /// \param const Expansion& other - expansion multiplied by
+        /// \return Expansion - the product
+        Expansion product(const Expansion& other);
+
+        /// \brief
+        ///
+        /// Finds the sign of the number held
+        /// \return int - 1 if positive, -1 if negative, 0 if zero
+        int sign();
+
+    private:
+
+        // Instance variable storing the non-zero components,
+        // smallest in magnitude first, empty for zero
+        std::vector<double> components;
+
+        /// \brief
+        ///
+        /// Adds a double to the expansion in place
+        /// \param double b - value added
+        void grow(double b);
+
+        /// \brief
+        ///
+        /// Calculates the exact product of this expansion and a double
+        /// \param double b - value multiplied by
+        /// \return Expansion - the product
+        Expansion scale(double b);
+
+};
+
+#endif // _expansion_h
@@ -8,278 +8,1055 @@
 /// dijkstra's algorithm and breadth first search
 
 #include "graph.h"
+#include "threadpool.h"
+#include "concurrentdisjointset.h"
+#include "delaunay.h"
+
+// Constant marking a component with no lightest edge found yet,
+// and the end of a chain of edges added since the adjacency was built
+const unsigned int NO_EDGE = 0xFFFFFFFF;
+
+// Constant defining how many blocks of edges each worker scans per
+// Boruvka round, each block is one task of the thread pool
+const unsigned int BLOCKS_PER_WORKER = 4;
+
+// Constant defining the number of edges below which filter-Kruskal
+// sorts a partition outright instead of splitting it further
+const unsigned int FILTER_THRESHOLD = 1024;
+
+// Orders edges by weight then by index, a strict order shared by every
+// minimum spanning tree algorithm so they all select the same tree, and
+// under which the lightest edges leaving the components never form a cycle
+struct LighterEdge {
+    const WeightedEdge* edges;
+    bool operator()(unsigned int e, unsigned int f) const {
+        return edges[e].weight < edges[f].weight
+               || (edges[e].weight == edges[f].weight && e < f);
+    }
+};
 
 /// Encapsulates instance variables to emulate a graph;
-/// the number of vertices in the graph, a 2-dimensional array
-/// to emulate an adjacency matrix, a queue collection to store edges and
-/// a set collection to store pointers to vertices.
+/// the number of vertices in the graph, a compressed sparse row
+/// adjacency store built from the flat list of added edges, the order of
+/// those edges by weight and a vector collection owning the vertices.
 /// Also includes methods for calculating the minimim spanning tree cost,
 /// and shortest distances from vertices towards a source through dijksta's
-/// algorithm and breadth width search
+/// algorithm and breadth width search. The working state of each search is
+/// kept in a query context, so once all edges are added any number of threads
+/// can search the graph at once, each with its own context
 
 /// \brief
 ///
-/// Constructor, initializes the number of vertices in the graph
-/// and the adjacency matrix
+/// Constructor, initializes the number of vertices in the graph,
+/// the adjacency store stays empty until edges are added
 /// \param unsigned int - number of vertices
-Graph::Graph(unsigned int N){
-
+Graph::Graph(unsigned int N) : context(N) {
     numVertices = N;
-
-    // Initialize 2 dimensional array to emulate the adjacency matrix
-    // sets weight values between vertices to infinity by default
-    // and zero where vertices are the same
-    weights = new double*[N];
-
-    for (unsigned i = 0; i < N; i++) {
-        weights[i] = new double[N];
-
-        for (unsigned j = 0; j < N; j++) {
-            weights[i][j] = INFINITY;
-        }
-        weights[i][i] = 0;
-    }
-
+    edges = edgeList.data();
+    numEdges = 0;
+    adjacencyStale = true;
+    sortedStale = true;
+    coordinateData = NULL;
+    treeCost = 0;
+    treeMaintained = false;
+    forestStale = true;
+    treeAdjacencyStale = true;
+    pathsMaintained = false;
+    firstPending = 0;
 }
 
 /// \brief
 ///
-/// Destructor, deletes the adjacency matrix
+/// Destructor, the adjacency store and collections clean up after themselves
 Graph::~Graph(){
-
-    // Delete the embedded arrays then the array
-    for (unsigned i = 0; i < numVertices; i++) {
-        delete[] weights[i];
-    }
-
-    delete[] weights;
-
 }
 
 /// \brief
 ///
-/// Adds vertices to the graph's vertices collection
+/// Adds a copy of a vertex to the graph's vertices collection,
+/// the graph does not keep the pointer so the caller still owns the vertex
 /// \param Vertex* - pointer to the vertex to be added
 void Graph::addVertex(Vertex* v){
-    vertices.push_back(v);
+    vertices.push_back(*v);
 }
 
 /// \brief
 ///
-/// Getter for a vertex at a specified identifier/index
+/// Creates the vertices for every identifier from the number already
+/// in the vertices collection up to a count, all in one contiguous block
+/// \param unsigned int - number of vertices the collection is to hold
+void Graph::reserveVertices(unsigned int count){
+    vertices.reserve(count);
+    for (unsigned int i = vertices.size(); i < count; i++) {
+        vertices.push_back(Vertex(i));
+    }
+}
+
+/// \brief
+///
+/// Getter for a vertex at a specified identifier/index, the pointer
+/// stays valid until more vertices are added
 /// \param int - identifier/index
 /// \return Vertex* - pointer to the vertex
 Vertex* Graph::getVertex(int i){
-    return vertices.at(i);
+    return &vertices.at(i);
+}
+
+/// \brief
+///
+/// Simple getter for the number of vertices in the graph
+/// \return unsigned int - number of vertices
+unsigned int Graph::getNumVertices(){
+    return numVertices;
 }
 
 /// \brief
 ///
-/// Adds vertices to the graph's edge queue collection
+/// Getter for the adjacency store, rebuilt first if edges
+/// have been added since it was last built
+/// \return CompressedSparseRow& - reference to the adjacency store
+CompressedSparseRow& Graph::getAdjacency(){
+    updateAdjacency();
+    return adjacency;
+}
+
+/// \brief
+///
+/// Adds an edge to the graph's edge list, the adjacency store is rebuilt
+/// from the list before the next search and the edges resorted before the
+/// next minimum spanning tree. The graph records the edge by its end point
+/// IDs and does not keep the pointer, so the caller still owns the edge
 /// \param Edge* - pointer to edge
 void Graph::addEdge(Edge* e){
+    addEdge(e->getSource()->getId(), e->getDestination()->getId(), e->getWeight());
+}
+
+/// \brief
+///
+/// Adds an edge between two vertices to the graph's edge list
+/// \param unsigned int source - source vertex's ID
+/// \param unsigned int destination - destination vertex's ID
+/// \param double weight - weight of the edge
+void Graph::addEdge(unsigned int source, unsigned int destination, double weight){
+    WeightedEdge record;
+    record.source = source;
+    record.destination = destination;
+    record.weight = weight;
+    addEdges(&record, 1);
+}
+
+/// \brief
+///
+/// Adds many edges to the graph's edge list at once, copied in order
+/// \pre - the edges are not held by this graph
+/// \param const WeightedEdge* added - first edge to be added
+/// \param unsigned int count - number of edges
+void Graph::addEdges(const WeightedEdge* added, unsigned int count){
+
+    // Edges viewed in a graph file are copied out before the first
+    // edge is added, and the graph owns its edges from then on
+    if (edges != edgeList.data()) {
+        edgeList.assign(edges, edges + numEdges);
+    }
 
-    // Alter the weight values of
-    // the adjacency matrix corresponding to weight of edges
-    unsigned src = e->getSource()->getId();
-    unsigned dst = e->getDestination()->getId();
-    double w = e->getWeight();
+    // The adjacency store is rebuilt lazily so bulk additions stay linear
+    unsigned int first = edgeList.size();
+    edgeList.insert(edgeList.end(), added, added + count);
+    edges = edgeList.data();
+    numEdges = edgeList.size();
+    adjacencyStale = true;
+    sortedStale = true;
+
+    // A minimum spanning tree already calculated is kept up to date
+    if (treeMaintained) {
+        for (unsigned int e = first; e < numEdges; e++) {
+            insertTreeEdge(edges[e], e);
+        }
+    }
 
-    weights[src][dst] = w;
-    weights[dst][src] = w;
+    // As is a shortest path tree, without rebuilding the adjacency store
+    if (pathsMaintained) {
+        repairShortestPaths(first);
+    }
+}
 
-    // Add edge to the edges queue collection
-    edges.push(e);
+/// \brief
+///
+/// Uses the edges, adjacency and coordinates held in an open graph file
+/// as the graph's storage in place of copies, replacing any edges and
+/// coordinates added before. Adding edges or setting coordinates later
+/// copies them out of the file first
+/// \pre - the graph was constructed with the file's number of vertices
+/// \pre - the file stays open while the graph uses it
+/// \param GraphFile& file - open graph file
+void Graph::useFile(GraphFile& file){
+
+    std::lock_guard<std::mutex> lock(adjacencyMutex);
+
+    std::vector<WeightedEdge>().swap(edgeList);
+    edges = file.getEdges();
+    numEdges = file.getNumEdges();
+    adjacency.view(numVertices, file.getOffsets(), file.getTargets(), file.getWeights());
+    adjacencyStale = false;
+    sortedStale = true;
+    treeMaintained = false;
+    pathsMaintained = false;
+
+    std::vector<double>().swap(coordinates);
+    coordinateData = file.getCoordinates();
 }
 
 /// \brief
 ///
-/// Calculates the minimum spanning tree cost using the edge queue collection
-/// through Kruskals Algorithm
-/// Also sets up the adjacency list for vertices in the graph
-/// \pre - all edges have added to edges queue collection
+/// Calculates the minimum spanning tree cost using the edge list
+/// through Kruskals Algorithm, the edges are sorted once and the order
+/// kept until more are added, the edge list itself is left unchanged
+/// Also sets up the adjacency list for vertices in the graph,
+/// replacing the tree of any earlier call
+/// \pre - all edges have been added
 /// \param double - minimum spanning tree cost
 double Graph::minimumSpanningTreeCost(){
 
+    clearTree();
+
+    // Sort the edge indices by weight, unless
+    // no edges were added since the last sort
+    if (sortedStale) {
+        sortedEdges.resize(numEdges);
+        for (unsigned int e = 0; e < sortedEdges.size(); e++) {
+            sortedEdges[e] = e;
+        }
+        LighterEdge lighter = { edges };
+        std::sort(sortedEdges.begin(), sortedEdges.end(), lighter);
+        sortedStale = false;
+    }
+
     // Initializes values disjoint set object
     double minCost = 0;
     DisjointSet ds = DisjointSet(numVertices);
     unsigned int edgeCount = 0;
 
-    // Poll the edges from queue collection,
+    // Walk the edges from lightest to heaviest,
     // where vertices do not belong to the same subset,
     // generate adjacency list for the vertices making up the edge
     // and increment the minimum cost based on the edge weight
-    while(!edges.empty() && edgeCount < numVertices - 1){
-        Edge* e = edges.top();
-        edges.pop();
-        int p = e->getSource()->getId();
-        int q = e->getDestination()->getId();
-        if(!ds.sameComponent(p, q)){
+    for (unsigned i = 0; i < sortedEdges.size() && edgeCount + 1 < numVertices; i++) {
+        if (addTreeEdge(edges[sortedEdges[i]], sortedEdges[i], ds, minCost)) {
             edgeCount++;
-            ds.join(p, q);
-            e->getDestination()->addAdjacency(p);
-            e->getSource()->addAdjacency(q);
-            minCost = minCost + e->getWeight();
         }
     }
     return minCost;
 }
 
+/// \brief
+///
+/// Calculates the minimum spanning tree cost using the specified algorithm,
+/// ties between equal weights are broken by the order edges were added
+/// so every algorithm selects the same tree when the weights are distinct
+/// Also sets up the adjacency list for vertices in the graph,
+/// replacing the tree of any earlier call
+/// \pre - all edges have been added, or for EUCLIDEAN coordinates set
+/// for all vertices, without which the added edges are used instead
+/// \param MstAlgorithm algorithm - algorithm to use
+/// \param unsigned int numThreads - number of threads for parallel
+/// algorithms, 0 for one per hardware thread
+/// \return double - minimum spanning tree cost
+double Graph::minimumSpanningTreeCost(MstAlgorithm algorithm, unsigned int numThreads){
+    if (algorithm == FILTER_KRUSKAL) {
+        clearTree();
+        std::vector<unsigned int> work(numEdges);
+        for (unsigned int e = 0; e < work.size(); e++) {
+            work[e] = e;
+        }
+
+        double minCost = 0;
+        DisjointSet ds = DisjointSet(numVertices);
+        unsigned int edgeCount = 0;
+        filterKruskal(work.data(), work.data() + work.size(), ds, edgeCount, minCost);
+        return minCost;
+    }
+    if (algorithm == BORUVKA) {
+        return boruvka(numThreads);
+    }
+    if (algorithm == EUCLIDEAN && coordinateData != NULL) {
+        return euclideanMinimumSpanningTreeCost();
+    }
+    return minimumSpanningTreeCost();
+}
+
+/// \brief
+///
+/// Simple getter for the cost of the minimum spanning tree. Once a tree
+/// has been calculated from the edge list, every edge added after is
+/// inserted into it, replacing the heaviest edge of the cycle it closes
+/// if lighter, or joining two trees of the forest, in amortized O(log N)
+/// time. A tree over the coordinates (EUCLIDEAN) is left as calculated
+/// \return double - cost of the tree, 0 if none has been calculated
+double Graph::getSpanningTreeCost(){
+    return treeCost;
+}
+
+/// \brief
+///
+/// Simple getter for the edges of the minimum spanning tree kept up to
+/// date as edges are added, in no particular order
+/// \param vector<WeightedEdge>& tree - filled with the edges of the tree
+void Graph::getSpanningTreeEdges(std::vector<WeightedEdge>& tree){
+    tree = treeEdges;
+}
+
 /// \brief
 ///
 /// Calculates and outputs the minimum distance and path
 /// between all vertices towards a specified source using Dijkstra's algorithm
-/// \pre - adjacency matrix initialized
 /// \pre - all vertices have been added to the vertices collection
 /// \param unsigned int - source vertex's ID
 void Graph::dijkstra(unsigned int sourceId){
+    ShortestPathTree tree;
+    shortestPaths(sourceId, tree);
+    outputPaths(tree);
+}
 
-    // Initialize the a queue to store vertices
-    std::priority_queue<Vertex*, std::vector<Vertex*>, Vertex> vertexQueue;
-
-    // Sets all vertices' predecessor ID and minimum distance to the sourceID
-    // and adds them to the queue
-    for(std::vector<Vertex*>::iterator it=vertices.begin(); it!=vertices.end(); ++it){
+/// \brief
+///
+/// Calculates the minimum distance and path from a source vertex
+/// to every vertex using Dijkstra's algorithm
+/// \param unsigned int source - source vertex's ID
+/// \param ShortestPathTree& tree - filled with the distances and paths
+void Graph::shortestPaths(unsigned int source, ShortestPathTree& tree){
+
+    updateAdjacency();
+    const unsigned int* offsets = adjacency.getOffsets();
+    const unsigned int* targets = adjacency.getTargets();
+    const double* edgeWeights = adjacency.getWeights();
+
+    tree.reset(numVertices, source);
+    double* distance = tree.distance.data();
+    unsigned int* predecessor = tree.predecessor.data();
+    tree.queue.push(source, 0);
+
+    while (!tree.queue.isEmpty()) {
+
+        // Poll the closest unsettled vertex from the queue
+        unsigned int u = tree.queue.pop();
+        double du = distance[u];
+        GRAPH_STATS_COUNT(VERTICES_SETTLED, 1);
+        GRAPH_STATS_COUNT(RELAXATIONS, offsets[u + 1] - offsets[u]);
+
+        // Modify adjacent vertices' min distance and predecessor ID where appropriate,
+        // lowering their key in the queue so they are settled in distance order
+        for (unsigned i = offsets[u]; i < offsets[u + 1]; i++) {
+            unsigned int v = targets[i];
+            double dv = du + edgeWeights[i];
+            if (dv < distance[v]) {
+                distance[v] = dv;
+                predecessor[v] = u;
+                tree.queue.pushOrDecrease(v, dv);
+            }
+        }
+    }
+}
 
-        (*it)->setDiscovered(false);
-        (*it)->setPredecessorId(sourceId);
-        (*it)->setMinDistance(weights[sourceId][(*it)->getId()]);
-        vertexQueue.push(*it);
+/// \brief
+///
+/// Calculates and outputs the minimum distance and path
+/// between all vertices towards a specified source through
+/// Breadth Width Search
+/// \pre - all vertices have been added to the vertices collection
+/// \pre - adjacencies of vertices initialized by MST
+/// \param unsigned int - source vertex's ID
+void Graph::bfs(unsigned int sourceId){
+    ShortestPathTree tree;
+    breadthFirstPaths(sourceId, tree);
+    outputPaths(tree);
+}
 
+/// \brief
+///
+/// Finds the path from a source vertex to every vertex along the
+/// edges of the minimum spanning tree through breadth first search,
+/// and the distance covered by each, from the weights of the tree edges
+/// \pre - adjacencies of vertices initialized by MST
+/// \param unsigned int source - source vertex's ID
+/// \param ShortestPathTree& tree - filled with the distances and paths
+void Graph::breadthFirstPaths(unsigned int source, ShortestPathTree& tree){
+
+    // The tree edges carry their own weights, which a Euclidean
+    // tree's straight line edges do not have in the edge list
+    if (treeAdjacencyStale) {
+        treeAdjacency.build(numVertices, treeEdges.data(), treeEdges.size());
+        treeAdjacencyStale = false;
     }
+    const unsigned int* offsets = treeAdjacency.getOffsets();
+    const unsigned int* targets = treeAdjacency.getTargets();
+    const double* edgeWeights = treeAdjacency.getWeights();
+
+    tree.reset(numVertices, source);
+    std::vector<unsigned int>& frontier = tree.frontier;
+    frontier.push_back(source);
+
+    // Poll the queue and set the predecessor ID of adjacent, undiscovered
+    // vertices to the polled vertex, with the distance covered up to it,
+    // and propagate this effect by adding them to the queue
+    for (size_t head = 0; head < frontier.size(); head++) {
+        unsigned int u = frontier[head];
+
+        GRAPH_STATS_COUNT(VERTICES_SETTLED, 1);
+        GRAPH_STATS_COUNT(RELAXATIONS, offsets[u + 1] - offsets[u]);
+        for (unsigned i = offsets[u]; i < offsets[u + 1]; i++) {
+            unsigned int v = targets[i];
+            if (!tree.isReachable(v)) {
+                tree.predecessor[v] = u;
+                tree.distance[v] = tree.distance[u] + edgeWeights[i];
+                frontier.push_back(v);
+            }
+        }
+    }
+}
 
-    while(!vertexQueue.empty()){
+/// \brief
+///
+/// Outputs the distance and path from the source of a tree to every
+/// other vertex, one line per vertex in order of ID
+/// \param ShortestPathTree& tree - tree filled by a search
+void Graph::outputPaths(ShortestPathTree& tree){
+    OutputWriter writer(std::cout);
+    outputPaths(tree, writer);
+}
 
-        // Poll from queue and set discovered
-        Vertex* currentVertex = vertexQueue.top();
-        vertexQueue.pop();
-        currentVertex->setDiscovered(true);
+/// \brief
+///
+/// Outputs the distance and path from the source of a tree to every
+/// other vertex, one line per vertex in order of ID, through a writer
+/// \param ShortestPathTree& tree - tree filled by a search
+/// \param OutputWriter& writer - writer to output to
+void Graph::outputPaths(ShortestPathTree& tree, OutputWriter& writer){
+
+    // One path collection is reused for every vertex
+    std::vector<unsigned int> path;
+    for (unsigned int v = 0; v < tree.getNumVertices(); v++) {
+        if (v != tree.getSource()) {
+            outputPath(tree, v, path, writer);
+        }
+    }
+}
 
-        // Create local instances of current ID and minDistance
-        int currentId = currentVertex->getId();
-        double currentMinDistance = currentVertex->getMinDistance();
+/// \brief
+///
+/// Calculates the minimum distance and path from a source vertex
+/// to a single target vertex using Dijkstra's algorithm, stopping
+/// as soon as the target is settled
+/// \param unsigned int source - source vertex's ID
+/// \param unsigned int target - target vertex's ID
+/// \param vector<unsigned int>& path - filled with the vertex IDs
+/// from source to target, left empty if there is no path
+/// \return double - distance of the path, INFINITY if there is no path
+double Graph::shortestPath(unsigned int source, unsigned int target, std::vector<unsigned int>& path){
+    return shortestPath(source, target, path, context);
+}
 
-        // Modify adjacent vertices' min distance and predecessor ID where appropriate
-        // and have the same repeated on the qualifying adjacency until all have been processed
-        for(unsigned i = 0; i < vertices.size(); i++){
+/// \brief
+///
+/// Calculates the minimum distance and path from a source vertex
+/// to a single target vertex using Dijkstra's algorithm, stopping
+/// as soon as the target is settled
+/// \param unsigned int source - source vertex's ID
+/// \param unsigned int target - target vertex's ID
+/// \param vector<unsigned int>& path - filled with the vertex IDs
+/// from source to target, left empty if there is no path
+/// \param QueryContext& context - context holding the working state of the search
+/// \return double - distance of the path, INFINITY if there is no path
+double Graph::shortestPath(unsigned int source, unsigned int target, std::vector<unsigned int>& path,
+                           QueryContext& context){
+
+    updateAdjacency();
+    const unsigned int* offsets = adjacency.getOffsets();
+    const unsigned int* targets = adjacency.getTargets();
+    const double* edgeWeights = adjacency.getWeights();
+
+    path.clear();
+    context.start(numVertices, source, target);
+    QueryContext::Search& search = context.forward;
+    unsigned int epoch = context.epoch;
+    double* distance = search.distance.data();
+    unsigned int* predecessor = search.predecessor.data();
+    unsigned int* reached = search.reached.data();
+    search.queue.push(source, 0);
+
+    // Settle vertices in distance order until the target is reached
+    while (!search.queue.isEmpty()) {
+
+        unsigned int u = search.queue.pop();
+        search.settled[u] = epoch;
+        GRAPH_STATS_COUNT(VERTICES_SETTLED, 1);
+        if (u == target) break;
+
+        double du = distance[u];
+        GRAPH_STATS_COUNT(RELAXATIONS, offsets[u + 1] - offsets[u]);
+        for (unsigned i = offsets[u]; i < offsets[u + 1]; i++) {
+            unsigned int v = targets[i];
+            double dv = du + edgeWeights[i];
+            if (reached[v] != epoch || dv < distance[v]) {
+                reached[v] = epoch;
+                distance[v] = dv;
+                predecessor[v] = u;
+                search.queue.pushOrDecrease(v, dv);
+            }
+        }
+    }
 
-            Vertex* v = vertices.at(i);
-            double weight = weights[currentId][v->getId()];
+    double result = context.getDistance(target);
+    if (result != INFINITY) {
+        appendPath(target, search.predecessor, path);
+    }
+    return result;
+}
 
-            if(!v->isDiscovered() && v != currentVertex && weight != INFINITY){
+/// \brief
+///
+/// Calculates the minimum distance and path from a source vertex
+/// to a single target vertex by running Dijkstra's algorithm from
+/// both ends at once, stopping when the two searches meet
+/// \param unsigned int source - source vertex's ID
+/// \param unsigned int target - target vertex's ID
+/// \param vector<unsigned int>& path - filled with the vertex IDs
+/// from source to target, left empty if there is no path
+/// \return double - distance of the path, INFINITY if there is no path
+double Graph::bidirectionalShortestPath(unsigned int source, unsigned int target, std::vector<unsigned int>& path){
+    return bidirectionalShortestPath(source, target, path, context);
+}
 
-                if(currentMinDistance + weight < v->getMinDistance()){
+/// \brief
+///
+/// Calculates the minimum distance and path from a source vertex
+/// to a single target vertex by running Dijkstra's algorithm from
+/// both ends at once, stopping when the two searches meet
+/// \param unsigned int source - source vertex's ID
+/// \param unsigned int target - target vertex's ID
+/// \param vector<unsigned int>& path - filled with the vertex IDs
+/// from source to target, left empty if there is no path
+/// \param QueryContext& context - context holding the working state of the search
+/// \return double - distance of the path, INFINITY if there is no path
+double Graph::bidirectionalShortestPath(unsigned int source, unsigned int target, std::vector<unsigned int>& path,
+                                        QueryContext& context){
+
+    updateAdjacency();
+    const unsigned int* offsets = adjacency.getOffsets();
+    const unsigned int* targets = adjacency.getTargets();
+    const double* edgeWeights = adjacency.getWeights();
+
+    path.clear();
+    context.start(numVertices, source, target);
+    if (source == target) {
+        path.push_back(source);
+        return 0;
+    }
 
-                    v->setMinDistance(currentMinDistance + weight);
-                    v->setPredecessorId(currentId);
-                    vertexQueue.push(v);
-                }
+    QueryContext::Search& forwardSearch = context.forward;
+    QueryContext::Search& backwardSearch = context.backward;
+    unsigned int epoch = context.epoch;
+    forwardSearch.queue.push(source, 0);
+    backwardSearch.queue.push(target, 0);
+
+    // Best known path length and the edge where the two searches met on it
+    double best = INFINITY;
+    unsigned int meetForward = source;
+    unsigned int meetBackward = target;
+
+    // Expand whichever search has the closer frontier, every path through an
+    // unsettled vertex is at least the sum of the two smallest keys, so once
+    // that sum reaches the best known path it cannot be improved
+    while (!forwardSearch.queue.isEmpty() && !backwardSearch.queue.isEmpty()
+           && forwardSearch.queue.topKey() + backwardSearch.queue.topKey() < best) {
+
+        bool forward = forwardSearch.queue.topKey() <= backwardSearch.queue.topKey();
+        QueryContext::Search& search = forward ? forwardSearch : backwardSearch;
+        QueryContext::Search& other = forward ? backwardSearch : forwardSearch;
+
+        unsigned int u = search.queue.pop();
+        search.settled[u] = epoch;
+        double du = search.distance[u];
+
+        for (unsigned i = offsets[u]; i < offsets[u + 1]; i++) {
+            unsigned int v = targets[i];
+            double dv = du + edgeWeights[i];
+
+            if (search.reached[v] != epoch || dv < search.distance[v]) {
+                search.reached[v] = epoch;
+                search.distance[v] = dv;
+                search.predecessor[v] = u;
+                search.queue.pushOrDecrease(v, dv);
+            }
 
-            } //end if adjacent and unfound check
+            // Record a shorter path joining the two searches through this edge
+            if (other.reached[v] == epoch && dv + other.distance[v] < best) {
+                best = dv + other.distance[v];
+                meetForward = forward ? u : v;
+                meetBackward = forward ? v : u;
+            }
+        }
+    }
 
-        } // end for
+    if (best != INFINITY) {
 
-    } // end while
+        // Join the forward path up to the meeting edge with
+        // the reversed backward path from it to the target
+        appendPath(meetForward, forwardSearch.predecessor, path);
+        unsigned int v = meetBackward;
+        path.push_back(v);
+        while (v != target) {
+            v = backwardSearch.predecessor[v];
+            path.push_back(v);
+        }
+    }
 
-    // Output the minimum distance/path to the source
-    // for each vertex that is not the source
-    for(unsigned i = 0; i < vertices.size(); i++){
+    return best;
+}
 
-        Vertex* u = vertices.at(sourceId);
-        Vertex* v = vertices.at(i);
+/// \brief
+///
+/// Calculates the minimum distances from each of a list of source vertices
+/// to every vertex using Dijkstra's algorithm, running the sources in
+/// parallel across a pool of threads with separate working state per thread
+/// \param const vector<unsigned int>& sources - source vertices' IDs
+/// \param unsigned int numThreads - number of threads, 0 for one per hardware thread
+/// \param vector<double>& distances - filled with one row per source of the
+/// distance to every vertex, INFINITY for those that cannot be reached
+/// \param vector<unsigned int>* predecessors - filled with one row per source
+/// of the vertex preceding every vertex on its path, the vertex itself for the
+/// source and those that cannot be reached, or NULL if not needed
+void Graph::multiSourceShortestPaths(const std::vector<unsigned int>& sources, unsigned int numThreads,
+                                     std::vector<double>& distances, std::vector<unsigned int>* predecessors){
+
+    // The adjacency store is brought up to date before the threads
+    // start, after which they only read it
+    updateAdjacency();
+    const unsigned int* offsets = adjacency.getOffsets();
+    const unsigned int* targets = adjacency.getTargets();
+    const double* edgeWeights = adjacency.getWeights();
+
+    size_t cells = (size_t)sources.size() * numVertices;
+    distances.assign(cells, INFINITY);
+    if (predecessors != NULL) {
+        predecessors->resize(cells);
+    }
+
+    // Each search writes straight into its own row, so the only state a
+    // thread keeps between its searches is a queue, left empty by each
+    ThreadPool pool(numThreads);
+    std::vector<IndexedHeap> queues(pool.getNumWorkers(), IndexedHeap(numVertices));
+
+    pool.parallelFor(sources.size(), [&](unsigned int k, unsigned int worker) {
+        double* distance = distances.data() + (size_t)k * numVertices;
+        unsigned int* predecessor = NULL;
+        if (predecessors != NULL) {
+            predecessor = predecessors->data() + (size_t)k * numVertices;
+            for (unsigned int v = 0; v < numVertices; v++) {
+                predecessor[v] = v;
+            }
+        }
 
-        if(v != u) {
+        IndexedHeap& queue = queues[worker];
+        unsigned int source = sources[k];
+        distance[source] = 0;
+        queue.push(source, 0);
+
+        while (!queue.isEmpty()) {
+            unsigned int u = queue.pop();
+            double du = distance[u];
+            GRAPH_STATS_COUNT(VERTICES_SETTLED, 1);
+            GRAPH_STATS_COUNT(RELAXATIONS, offsets[u + 1] - offsets[u]);
+            for (unsigned i = offsets[u]; i < offsets[u + 1]; i++) {
+                unsigned int v = targets[i];
+                double dv = du + edgeWeights[i];
+                if (dv < distance[v]) {
+                    distance[v] = dv;
+                    if (predecessor != NULL) predecessor[v] = u;
+                    queue.pushOrDecrease(v, dv);
+                }
+            }
+        }
+    });
+}
 
-            int source = u->getId();
-            int destination = v->getId();
-            double pathDistance = v->getMinDistance();
+/// \brief
+///
+/// Calculates the minimum distance and path from a source vertex to
+/// every vertex through delta-stepping, which settles the vertices in
+/// buckets of distances delta wide rather than one at a time. The edges
+/// of each bucket's vertices are relaxed in parallel, those no heavier
+/// than delta repeatedly until the bucket stays empty and the heavier
+/// ones once after. The distances are the same as Dijkstra's algorithm
+/// finds, and each vertex's predecessor is the first vertex along its
+/// adjacencies from which its distance is reached
+/// \param unsigned int source - source vertex's ID
+/// \param ShortestPathTree& tree - filled with the distances and paths
+/// \param double delta - width of the buckets, 0 to choose one from the
+/// edge weights
+/// \param unsigned int numThreads - number of threads, 0 for one per hardware thread
+void Graph::deltaSteppingShortestPaths(unsigned int source, ShortestPathTree& tree, double delta,
+                                       unsigned int numThreads){
+
+    updateAdjacency();
+    const unsigned int* offsets = adjacency.getOffsets();
+    const unsigned int* targets = adjacency.getTargets();
+    const double* edgeWeights = adjacency.getWeights();
+
+    if (!(delta > 0)) {
+        delta = defaultDelta();
+    }
 
-            std::string pathString;
+    // Distances are lowered by whichever thread finds a shorter one first,
+    // the bucket of a vertex is its distance divided by the bucket width
+    std::vector<std::atomic<double> > distance(numVertices);
+    for (unsigned int v = 0; v < numVertices; v++) {
+        distance[v].store(INFINITY, std::memory_order_relaxed);
+    }
+    distance[source].store(0, std::memory_order_relaxed);
+
+    std::vector<std::vector<unsigned int> > buckets(1, std::vector<unsigned int>(1, source));
+    std::vector<unsigned int> frontier;
+    std::vector<unsigned int> settled;
+    std::vector<unsigned int> stamp(numVertices, 0);
+    unsigned int round = 0;
+
+    ThreadPool pool(numThreads);
+    std::vector<std::vector<unsigned int> > lowered(pool.getNumWorkers());
+
+    // Relaxes the light or the heavy edges of every vertex of a list, each
+    // worker listing the vertices whose distances it lowered
+    auto relax = [&](const std::vector<unsigned int>& from, bool light) {
+        pool.parallelFor(from.size(), [&](unsigned int k, unsigned int worker) {
+            unsigned int u = from[k];
+            double du = distance[u].load(std::memory_order_relaxed);
+            for (unsigned i = offsets[u]; i < offsets[u + 1]; i++) {
+                if ((edgeWeights[i] <= delta) != light) continue;
+                GRAPH_STATS_COUNT(RELAXATIONS, 1);
+                unsigned int v = targets[i];
+                double dv = du + edgeWeights[i];
+                double current = distance[v].load(std::memory_order_relaxed);
+                while (dv < current) {
+                    if (distance[v].compare_exchange_weak(current, dv, std::memory_order_relaxed)) {
+                        lowered[worker].push_back(v);
+                        break;
+                    }
+                }
+            }
+        });
+
+        // Move every lowered vertex into the bucket of its new distance,
+        // where it may already be under an older distance. Copies left in
+        // a bucket after their vertex moved lower are skipped when taken
+        for (unsigned int w = 0; w < lowered.size(); w++) {
+            for (unsigned int v : lowered[w]) {
+                size_t b = (size_t) (distance[v].load(std::memory_order_relaxed) / delta);
+                if (b >= buckets.size()) {
+                    buckets.resize(b + 1);
+                }
+                buckets[b].push_back(v);
+            }
+            lowered[w].clear();
+        }
+    };
+
+    for (size_t current = 0; current < buckets.size(); current++) {
+
+        // Light edges can lower vertices into the current bucket again,
+        // so it is emptied repeatedly until it stays empty, each round
+        // relaxing every vertex in it once at its latest distance
+        settled.clear();
+        while (!buckets[current].empty()) {
+            frontier.clear();
+            frontier.swap(buckets[current]);
+
+            round++;
+            size_t kept = 0;
+            for (unsigned int v : frontier) {
+                if (stamp[v] != round && (size_t) (distance[v].load(std::memory_order_relaxed) / delta) == current) {
+                    stamp[v] = round;
+                    frontier[kept++] = v;
+                }
+            }
+            frontier.resize(kept);
+            settled.insert(settled.end(), frontier.begin(), frontier.end());
+            relax(frontier, true);
+        }
 
-            // Walk from vertex to source to contenate path
-            while(v != u) {
-                pathString = convertIntToString(v->getId()) + "  " + pathString;
-                v = vertices.at(v->getPredecessorId());
-            } // end while
+        // Heavy edges always reach a later bucket, so each settled
+        // vertex relaxes them once, at its final distance
+        std::sort(settled.begin(), settled.end());
+        settled.erase(std::unique(settled.begin(), settled.end()), settled.end());
+        GRAPH_STATS_COUNT(VERTICES_SETTLED, settled.size());
+        relax(settled, false);
+    }
 
-            pathString = convertIntToString(source) + "  " + pathString;
-            outputPath(source, destination, pathDistance, pathString);
+    // Record the distances, then give every vertex the first neighbour
+    // along its adjacencies that is strictly closer and whose distance
+    // leads exactly to its own
+    tree.reset(numVertices, source);
+    for (unsigned int v = 0; v < numVertices; v++) {
+        tree.distance[v] = distance[v].load(std::memory_order_relaxed);
+    }
+    const double* result = tree.distance.data();
+    unsigned int* predecessor = tree.predecessor.data();
+    std::vector<std::vector<unsigned int> > unresolved(pool.getNumWorkers());
+    pool.parallelFor(numVertices, [&](unsigned int v, unsigned int worker) {
+        if (v == source || result[v] == INFINITY) return;
+        for (unsigned i = offsets[v]; i < offsets[v + 1]; i++) {
+            unsigned int u = targets[i];
+            if (result[u] < result[v] && result[u] + edgeWeights[i] == result[v]) {
+                predecessor[v] = u;
+                return;
+            }
+        }
+        unresolved[worker].push_back(v);
+    });
+
+    // Vertices reached only across edges too light to add to the distance
+    // take a neighbour at the same distance that already has its path,
+    // spreading outwards so the paths never form a cycle
+    std::vector<unsigned int> waiting;
+    for (unsigned int w = 0; w < unresolved.size(); w++) {
+        waiting.insert(waiting.end(), unresolved[w].begin(), unresolved[w].end());
+    }
+    bool changed = true;
+    while (!waiting.empty() && changed) {
+        changed = false;
+        size_t kept = 0;
+        for (unsigned int v : waiting) {
+            bool found = false;
+            for (unsigned i = offsets[v]; i < offsets[v + 1] && !found; i++) {
+                unsigned int u = targets[i];
+                found = (u == source || predecessor[u] != u) && result[u] + edgeWeights[i] == result[v];
+                if (found) predecessor[v] = u;
+            }
+            if (found) {
+                changed = true;
+            } else {
+                waiting[kept++] = v;
+            }
+        }
+        waiting.resize(kept);
+    }
+}
 
-        } // end if source check
+/// \brief
+///
+/// Calculates the minimum distance and path from a source vertex to
+/// every vertex using Dijkstra's algorithm, and keeps them up to date
+/// as edges are added or made lighter, propagating each change only
+/// to the vertices whose distances improve, until another source is
+/// maintained or a graph file is used
+/// \param unsigned int source - source vertex's ID
+void Graph::maintainShortestPaths(unsigned int source){
+    shortestPaths(source, pathTree);
+    pathsMaintained = true;
+    clearPending();
+}
 
-    } // end for
+/// \brief
+///
+/// Simple getter for the shortest path tree kept up to date
+/// \pre - a source is maintained
+/// \return ShortestPathTree& - reference to the tree
+ShortestPathTree& Graph::getMaintainedPaths(){
+    return pathTree;
 }
 
 /// \brief
 ///
-/// Calculates and outputs the minimum distance and path
-/// between all vertices towards a specified source through
-/// Breadth Width Search
-/// \pre - adjacency matrix initialized
-/// \pre - all vertices have been added to the vertices collection
-/// \pre - adjacencies of vertices initialized by MST
-/// \param unsigned int - source vertex's ID
-void Graph::bfs(unsigned int sourceId){
+/// Lowers the weight of the lightest edge between two vertices in
+/// place, if the new weight is lower, repairing a minimum spanning
+/// tree or shortest path tree kept up to date from that edge alone
+/// \param unsigned int source - source vertex's ID
+/// \param unsigned int destination - destination vertex's ID
+/// \param double weight - new weight of the edge
+/// \return bool - true if the edge exists and was made lighter
+bool Graph::decreaseWeight(unsigned int source, unsigned int destination, double weight){
+
+    // Edges viewed in a graph file are copied out before they change,
+    // and the adjacency store rebuilt with the index of every edge
+    if (edges != edgeList.data()) {
+        edgeList.assign(edges, edges + numEdges);
+        edges = edgeList.data();
+        adjacencyStale = true;
+    }
 
-    // Set all vertices to undiscovered
-    for(std::vector<Vertex*>::iterator it=vertices.begin(); it!=vertices.end(); ++it){
-        (*it)->setDiscovered(false);
-    }
-
-    // Initialize a queue, sets the source vertice to discovered and add it to the queue
-    std::priority_queue<Vertex*> vertexQueue;
-    vertices.at(sourceId)->setDiscovered(true);
-    vertexQueue.push(vertices.at(sourceId));
-
-    // Poll the queue and modify the predecessor ID of points adjacent,
-    // undiscovered points to the polled vertice and propagate this effect
-    // by adding the qualifying vertices into the queue
-    while (!vertexQueue.empty()){
-        Vertex* u = vertexQueue.top();
-        vertexQueue.pop();
-
-        std::set<unsigned int>* adjacencies = u->getAdjacencies();
-        for(std::set<unsigned int>::iterator it = adjacencies->begin(); it!=adjacencies->end(); ++it){
-            if(!vertices.at(*it)->isDiscovered()){
-                vertices.at(*it)->setPredecessorId(u->getId());
-                vertices.at(*it)->setDiscovered(true);
-                vertexQueue.push(vertices.at(*it));
+    // Edges added since the store was built are found through their
+    // chains while a source is maintained, so it is only rebuilt otherwise
+    if (!pathsMaintained || adjacency.getEdgeIds() == NULL) {
+        updateAdjacency();
+    }
+    const unsigned int* offsets = adjacency.getOffsets();
+    const unsigned int* targets = adjacency.getTargets();
+    const unsigned int* edgeIds = adjacency.getEdgeIds();
+
+    // Find the lightest edge between the vertices, the one every
+    // search and spanning tree already takes between them
+    LighterEdge lighter = { edges };
+    unsigned int found = NO_EDGE;
+    for (unsigned i = offsets[source]; i < offsets[source + 1]; i++) {
+        if (targets[i] == destination && (found == NO_EDGE || lighter(edgeIds[i], found))) {
+            found = edgeIds[i];
+        }
+    }
+    if (pathsMaintained) {
+        for (unsigned int slot = pendingHead[source]; slot != NO_EDGE; slot = pendingNext[slot]) {
+            unsigned int e = firstPending + slot / 2;
+            unsigned int other = (slot & 1) ? edges[e].source : edges[e].destination;
+            if (other == destination && (found == NO_EDGE || lighter(e, found))) {
+                found = e;
             }
-        } // end for
-    } // end while
+        }
+    }
+    if (found == NO_EDGE || !(weight < edges[found].weight)) return false;
 
-    // Calculate and output the path and distance travelled by path for
-    // each vertice to the source
-    for(unsigned i = 0; i < vertices.size(); i++){
+    // Lower the edge in the list and in both rows of the store holding it
+    edgeList[found].weight = weight;
+    sortedStale = true;
+    for (unsigned i = offsets[source]; i < offsets[source + 1]; i++) {
+        if (edgeIds[i] == found) adjacency.setWeight(i, weight);
+    }
+    for (unsigned i = offsets[destination]; i < offsets[destination + 1]; i++) {
+        if (edgeIds[i] == found) adjacency.setWeight(i, weight);
+    }
 
-        Vertex* u = vertices.at(sourceId);
-        Vertex* v = vertices.at(i);
+    // A lighter edge only ever enters a minimum spanning tree, or stays in
+    // it, and only shortens paths through it, so both are repaired from it
+    if (treeMaintained) {
+        insertTreeEdge(edges[found], found);
+    }
+    if (pathsMaintained) {
+        lowerAcross(edges[found]);
+        settleLowered();
+    }
+    return true;
+}
 
-        if(v != u) {
+/// \brief
+///
+/// Stores the coordinates of a vertex, packed with those of the
+/// other vertices, so they can guide the A* search
+/// \param unsigned int id - vertex's ID
+/// \param Point* point - pointer to the vertex's location
+void Graph::setCoordinates(unsigned int id, Point* point){
+    // Coordinates viewed in a graph file are copied out before they change
+    if (coordinateData == NULL) {
+        coordinates.assign(2 * numVertices, 0);
+    } else if (coordinateData != coordinates.data()) {
+        coordinates.assign(coordinateData, coordinateData + 2 * numVertices);
+    }
+    coordinateData = coordinates.data();
+    coordinates[2 * id] = point->getX();
+    coordinates[2 * id + 1] = point->getY();
+}
 
-            int source = u->getId();
-            int destination = v->getId();
+/// \brief
+///
+/// Calculates the minimum distance and path from a source vertex
+/// to a single target vertex using the A* algorithm, ordering the
+/// search by distance travelled plus straight line distance remaining
+/// \pre - coordinates set for all vertices, or for none in which case
+/// the search is equivalent to shortestPath
+/// \pre - edge weights are at least the straight line distance
+/// between their end points
+/// \param unsigned int source - source vertex's ID
+/// \param unsigned int target - target vertex's ID
+/// \param vector<unsigned int>& path - filled with the vertex IDs
+/// from source to target, left empty if there is no path
+/// \return double - distance of the path, INFINITY if there is no path
+double Graph::aStar(unsigned int source, unsigned int target, std::vector<unsigned int>& path){
+    return aStar(source, target, path, context);
+}
 
-            double pathDistance = 0;
-            std::string pathOutPut = "";
+/// \brief
+///
+/// Calculates the minimum distance and path from a source vertex
+/// to a single target vertex using the A* algorithm, ordering the
+/// search by distance travelled plus straight line distance remaining
+/// \pre - coordinates set for all vertices, or for none in which case
+/// the search is equivalent to shortestPath
+/// \pre - edge weights are at least the straight line distance
+/// between their end points
+/// \param unsigned int source - source vertex's ID
+/// \param unsigned int target - target vertex's ID
+/// \param vector<unsigned int>& path - filled with the vertex IDs
+/// from source to target, left empty if there is no path
+/// \param QueryContext& context - context holding the working state of the search
+/// \return double - distance of the path, INFINITY if there is no path
+double Graph::aStar(unsigned int source, unsigned int target, std::vector<unsigned int>& path,
+                    QueryContext& context){
+
+    if (coordinateData == NULL) {
+        return shortestPath(source, target, path, context);
+    }
 
-            // Walk to source using the vertice's predecessor ID while incrementing
-            // the path distance based on edge weight and contenate the path ID for
-            // output
-            while(v != u) {
-                int currentVertexId = v->getId();
-                pathOutPut = convertIntToString(currentVertexId) + "  " + pathOutPut;
-                pathDistance += weights[currentVertexId][v->getPredecessorId()];
-                v = vertices.at(v->getPredecessorId());
-            } // end while
+    updateAdjacency();
+    const unsigned int* offsets = adjacency.getOffsets();
+    const unsigned int* targets = adjacency.getTargets();
+    const double* edgeWeights = adjacency.getWeights();
+    const double* xy = coordinateData;
+    double targetX = xy[2 * target];
+    double targetY = xy[2 * target + 1];
+
+    path.clear();
+    context.start(numVertices, source, target);
+    QueryContext::Search& search = context.forward;
+    unsigned int epoch = context.epoch;
+    double* distance = search.distance.data();
+    unsigned int* predecessor = search.predecessor.data();
+    unsigned int* reached = search.reached.data();
+    search.queue.push(source, 0);
+
+    // Settle vertices in order of distance travelled plus the straight line
+    // distance to the target, a lower bound that never decreases along an
+    // edge, so the target's distance is final once it is polled
+    while (!search.queue.isEmpty()) {
+
+        unsigned int u = search.queue.pop();
+        search.settled[u] = epoch;
+        GRAPH_STATS_COUNT(VERTICES_SETTLED, 1);
+        if (u == target) break;
+
+        double du = distance[u];
+        GRAPH_STATS_COUNT(RELAXATIONS, offsets[u + 1] - offsets[u]);
+        for (unsigned i = offsets[u]; i < offsets[u + 1]; i++) {
+            unsigned int v = targets[i];
+            double dv = du + edgeWeights[i];
+            if (reached[v] != epoch || dv < distance[v]) {
+                reached[v] = epoch;
+                distance[v] = dv;
+                predecessor[v] = u;
+
+                double dx = xy[2 * v] - targetX;
+                double dy = xy[2 * v + 1] - targetY;
+                search.queue.pushOrDecrease(v, dv + sqrt(dx * dx + dy * dy));
+            }
+        }
+    }
 
-            pathOutPut = convertIntToString(source) + "  " + pathOutPut;
-            outputPath(source, destination, pathDistance, pathOutPut);
+    double result = context.getDistance(target);
+    if (result != INFINITY) {
+        appendPath(target, search.predecessor, path);
+    }
+    return result;
+}
 
-        } // end if
-    } // end for
+/// \brief
+///
+/// Gathers the work counted by the searches, disjoint sets and minimum
+/// spanning trees of every thread and every graph since the last reset,
+/// all zero unless the program is compiled with GRAPH_STATS defined
+/// \return GraphStats - totals of the counters
+GraphStats Graph::getStats(){
+    return StatsRecorder::total();
+}
 
+/// \brief
+///
+/// Starts the counters again from zero
+void Graph::resetStats(){
+    StatsRecorder::reset();
 }
 
 /// \brief
@@ -289,55 +1066,655 @@ void Graph::bfs(unsigned int sourceId){
 /// \param ostream - reference to output stream
 /// \param Graph& - reference to graph
 std::ostream& operator<<(std::ostream& out, Graph& graph){
+    OutputWriter writer(out);
+    graph.outputMatrix(writer);
+    return out;
+}
+
+/// \brief
+///
+/// Outputs the adjacency matrix through a writer, one row per
+/// line with a dash where two vertices are not adjacent
+/// \param OutputWriter& - writer to output to
+void Graph::outputMatrix(OutputWriter& writer){
+
+    updateAdjacency();
+    const unsigned int* offsets = adjacency.getOffsets();
+    const unsigned int* targets = adjacency.getTargets();
+    const double* edgeWeights = adjacency.getWeights();
+
+    // Expand one row of the adjacency store at a time into a dense buffer,
+    // so only a single row of the matrix is ever held in memory
+    std::vector<double> row(numVertices);
+
+    for (unsigned i = 0; i < numVertices; i++) {
+        std::fill(row.begin(), row.end(), (double) INFINITY);
+        for (unsigned k = offsets[i]; k < offsets[i + 1]; k++) {
+            if (edgeWeights[k] < row[targets[k]]) {
+                row[targets[k]] = edgeWeights[k];
+            }
+        }
+        row[i] = 0;
 
-    for (unsigned i = 0; i < graph.numVertices; i++) {
-        for (unsigned j = 0; j < graph.numVertices; j++) {
-            if (graph.weights[i][j] == INFINITY) {
-                out << "      -";
+        for (unsigned j = 0; j < numVertices; j++) {
+            if (row[j] == INFINITY) {
+                writer.write("      -", 7);
             } else {
-                double weight = graph.weights[i][j];
-                out << std::fixed;
-                out << std::setprecision(2);
-                out << std::setw(7) << weight;
+                writer.writeFixed(row[j], 2, 7);
             }
         }
-        out << std::endl;
+        writer.write('\n');
     }
+}
 
-    return out;
+/// \brief
+///
+/// Rebuilds the adjacency store from the edge list if edges have been
+/// added since it was last built, under a lock so searches started
+/// together on several threads only rebuild it once
+void Graph::updateAdjacency(){
+
+    // Checked again under the lock, since another thread
+    // may have rebuilt the store while this one waited
+    if (!adjacencyStale.load(std::memory_order_acquire)) return;
+
+    std::lock_guard<std::mutex> lock(adjacencyMutex);
+    if (adjacencyStale.load(std::memory_order_relaxed)) {
+        adjacency.build(numVertices, edges, numEdges);
+        if (pathsMaintained) {
+            clearPending();
+        }
+        adjacencyStale.store(false, std::memory_order_release);
+    }
 }
 
 /// \brief
 ///
-/// Helper method for outputting the path from source point to
-/// a vertice and the distance covered by the path
-/// \pre path strings prepared by the algorithm methods
-/// \param int source - source vertex ID
-/// \param int destination - destination vertex ID
-/// \param double distance - distance covered by the path
-/// \param string path - string representation of the path
-void Graph::outputPath(int source, int destination, double distance, std::string path){
+/// Empties the chains of edges added since the adjacency store was
+/// built, after it is rebuilt or a source starts being maintained
+void Graph::clearPending(){
+    firstPending = numEdges;
+    pendingHead.assign(numVertices, NO_EDGE);
+    pendingNext.clear();
+}
 
-    if (distance == INFINITY) {
-        std::cout << "NO PATH  from ";
-        std::cout << source << " to  " << destination;
-        std::cout << std::endl;
+/// \brief
+///
+/// Repairs the maintained shortest path tree after edges are added,
+/// chaining each added edge from its end points, then lowering the
+/// distances across them and settling the vertices lowered
+/// \param unsigned int first - index of the first edge added
+void Graph::repairShortestPaths(unsigned int first){
+
+    // Chain the added edges from both end points, so the lowered
+    // vertices find them until the adjacency store is rebuilt, and
+    // queue the end points they lead to a shorter path to
+    for (unsigned int e = first; e < numEdges; e++) {
+        const WeightedEdge& added = edges[e];
+        unsigned int slot = 2 * (e - firstPending);
+        pendingNext.push_back(pendingHead[added.source]);
+        pendingNext.push_back(pendingHead[added.destination]);
+        pendingHead[added.source] = slot;
+        pendingHead[added.destination] = slot + 1;
+        lowerAcross(added);
+    }
+    settleLowered();
+}
+
+/// \brief
+///
+/// Lowers the distance of either end point of an edge in the
+/// maintained shortest path tree if the edge leads to it on a
+/// shorter path, queueing the end point lowered
+/// \param const WeightedEdge& e - edge added or made lighter
+void Graph::lowerAcross(const WeightedEdge& e){
+
+    double* distance = pathTree.distance.data();
+    unsigned int* predecessor = pathTree.predecessor.data();
+    GRAPH_STATS_COUNT(RELAXATIONS, 2);
+
+    if (distance[e.source] + e.weight < distance[e.destination]) {
+        distance[e.destination] = distance[e.source] + e.weight;
+        predecessor[e.destination] = e.source;
+        pathTree.queue.pushOrDecrease(e.destination, distance[e.destination]);
+    } else if (distance[e.destination] + e.weight < distance[e.source]) {
+        distance[e.source] = distance[e.destination] + e.weight;
+        predecessor[e.source] = e.destination;
+        pathTree.queue.pushOrDecrease(e.source, distance[e.source]);
+    }
+}
+
+/// \brief
+///
+/// Settles the vertices queued in the maintained shortest path tree
+/// in distance order, as Dijkstra's algorithm does, so only they and
+/// their edges are visited
+void Graph::settleLowered(){
+
+    // The distances of every other vertex are still upper bounds reached
+    // through the tree, so settling the lowered vertices from closest
+    // first, as Dijkstra's algorithm does, finds every distance improved
+    double* distance = pathTree.distance.data();
+    unsigned int* predecessor = pathTree.predecessor.data();
+    const unsigned int* offsets = adjacency.getOffsets();
+    const unsigned int* targets = adjacency.getTargets();
+    const double* edgeWeights = adjacency.getWeights();
+
+    while (!pathTree.queue.isEmpty()) {
+
+        unsigned int u = pathTree.queue.pop();
+        double du = distance[u];
+        GRAPH_STATS_COUNT(VERTICES_SETTLED, 1);
+        GRAPH_STATS_COUNT(RELAXATIONS, offsets[u + 1] - offsets[u]);
+
+        for (unsigned i = offsets[u]; i < offsets[u + 1]; i++) {
+            unsigned int v = targets[i];
+            double dv = du + edgeWeights[i];
+            if (dv < distance[v]) {
+                distance[v] = dv;
+                predecessor[v] = u;
+                pathTree.queue.pushOrDecrease(v, dv);
+            }
+        }
+
+        // Then the edges added since the store was built, the slot
+        // of each end point giving the edge and which end it is
+        for (unsigned int slot = pendingHead[u]; slot != NO_EDGE; slot = pendingNext[slot]) {
+            const WeightedEdge& added = edges[firstPending + slot / 2];
+            unsigned int v = (slot & 1) ? added.source : added.destination;
+            double dv = du + added.weight;
+            GRAPH_STATS_COUNT(RELAXATIONS, 1);
+            if (dv < distance[v]) {
+                distance[v] = dv;
+                predecessor[v] = u;
+                pathTree.queue.pushOrDecrease(v, dv);
+            }
+        }
+    }
+}
+
+/// \brief
+///
+/// Appends the path ending at a vertex to a path collection by
+/// walking a predecessor array back to the start of the search
+/// \param unsigned int end - last vertex of the path
+/// \param const vector<unsigned int>& predecessor - predecessor array to walk
+/// \param vector<unsigned int>& path - collection the path is appended to
+void Graph::appendPath(unsigned int end, const std::vector<unsigned int>& predecessor, std::vector<unsigned int>& path){
+
+    // Walk back to the start, then reverse the walked section in place
+    size_t first = path.size();
+    unsigned int v = end;
+    path.push_back(v);
+    while (predecessor[v] != v) {
+        v = predecessor[v];
+        path.push_back(v);
+    }
+    std::reverse(path.begin() + first, path.end());
+}
+
+/// \brief
+///
+/// Chooses the bucket width for delta-stepping, the heaviest edge
+/// weight divided by the average degree as Meyer and Sanders suggest,
+/// so that most edges are light while buckets stay narrow
+/// \return double - bucket width, greater than 0
+double Graph::defaultDelta(){
+
+    double heaviest = 0;
+    for (unsigned int e = 0; e < numEdges; e++) {
+        if (edges[e].weight > heaviest) {
+            heaviest = edges[e].weight;
+        }
+    }
+    if (heaviest <= 0) return 1;
+
+    double averageDegree = 2.0 * numEdges / numVertices;
+    return averageDegree > 1 ? heaviest / averageDegree : heaviest;
+}
+
+/// \brief
+///
+/// Calculates the minimum spanning tree cost through Boruvka's algorithm,
+/// each round finds the lightest edge leaving every component in parallel
+/// and joins the components along those edges
+/// \param unsigned int numThreads - number of threads, 0 for one per hardware thread
+/// \return double - minimum spanning tree cost
+double Graph::boruvka(unsigned int numThreads){
+
+    clearTree();
+    ThreadPool pool(numThreads);
+    const WeightedEdge* edgeData = edges;
+    LighterEdge lighter = { edgeData };
+
+    // Each vertex is labelled with the root of its component, the live
+    // edges are those whose end points are still in different components
+    std::vector<unsigned int> component(numVertices);
+    std::vector<unsigned int> roots(numVertices);
+    for (unsigned int v = 0; v < numVertices; v++) {
+        component[v] = v;
+        roots[v] = v;
+    }
+
+    std::vector<unsigned int> live;
+    live.reserve(numEdges);
+    for (unsigned int e = 0; e < numEdges; e++) {
+        if (edgeData[e].source != edgeData[e].destination) {
+            live.push_back(e);
+        }
+    }
+
+    std::vector<std::atomic<unsigned int> > cheapest(numVertices);
+    std::vector<unsigned int> newLabel(numVertices);
+    std::vector<unsigned int> chosen;
+    std::vector<unsigned int> pairs;
+    std::vector<char> joined;
+    unsigned int numBlocks = pool.getNumWorkers() * BLOCKS_PER_WORKER;
+    std::vector<std::vector<unsigned int> > kept(numBlocks);
+    ConcurrentDisjointSet ds(numVertices);
+
+    while (!live.empty()) {
+
+        for (unsigned i = 0; i < roots.size(); i++) {
+            cheapest[roots[i]].store(NO_EDGE, std::memory_order_relaxed);
+        }
+
+        // Find the lightest live edge of every component, each block of edges
+        // offers its edges to both end components through compare and swap
+        unsigned int blockSize = (live.size() + numBlocks - 1) / numBlocks;
+        pool.parallelFor(numBlocks, [&](unsigned int block, unsigned int) {
+            unsigned int begin = block * blockSize;
+            unsigned int end = std::min<size_t>(begin + blockSize, live.size());
+
+            for (unsigned int i = begin; i < end; i++) {
+                unsigned int e = live[i];
+                unsigned int ends[2] = { component[edgeData[e].source], component[edgeData[e].destination] };
+
+                for (unsigned k = 0; k < 2; k++) {
+                    std::atomic<unsigned int>& slot = cheapest[ends[k]];
+                    unsigned int current = slot.load(std::memory_order_relaxed);
+                    while ((current == NO_EDGE || lighter(e, current))
+                           && !slot.compare_exchange_weak(current, e, std::memory_order_relaxed)) {
+                    }
+                }
+            }
+        });
+
+        // Join the components along their lightest edges in parallel, an
+        // edge chosen by both of its components only succeeds in joining once
+        chosen.clear();
+        pairs.clear();
+        for (unsigned i = 0; i < roots.size(); i++) {
+            unsigned int e = cheapest[roots[i]].load(std::memory_order_relaxed);
+            if (e != NO_EDGE) {
+                chosen.push_back(e);
+                pairs.push_back(edgeData[e].source);
+                pairs.push_back(edgeData[e].destination);
+            }
+        }
+        joined.resize(chosen.size());
+        ds.joinMany(pairs.data(), chosen.size(), pool, joined.data());
+
+        for (unsigned i = 0; i < chosen.size(); i++) {
+            if (!joined[i]) continue;
+            recordTreeEdge(edgeData[chosen[i]], chosen[i]);
+        }
+
+        // Relabel every vertex with the root of its merged component,
+        // only the old roots need a find, the vertices follow their root
+        unsigned int rootBlock = (roots.size() + numBlocks - 1) / numBlocks;
+        pool.parallelFor(numBlocks, [&](unsigned int block, unsigned int) {
+            unsigned int begin = block * rootBlock;
+            unsigned int end = std::min<size_t>(begin + rootBlock, roots.size());
+            for (unsigned int i = begin; i < end; i++) {
+                newLabel[roots[i]] = ds.find(roots[i]);
+            }
+        });
+
+        std::vector<unsigned int> newRoots;
+        for (unsigned i = 0; i < roots.size(); i++) {
+            if (newLabel[roots[i]] == roots[i]) {
+                newRoots.push_back(roots[i]);
+            }
+        }
+        roots.swap(newRoots);
+
+        unsigned int vertexBlock = (numVertices + numBlocks - 1) / numBlocks;
+        pool.parallelFor(numBlocks, [&](unsigned int block, unsigned int) {
+            unsigned int begin = block * vertexBlock;
+            unsigned int end = std::min(begin + vertexBlock, numVertices);
+            for (unsigned int v = begin; v < end; v++) {
+                component[v] = newLabel[component[v]];
+            }
+        });
+
+        // Drop the edges that now lie inside a component, each block keeps
+        // its survivors in order and the blocks are joined back together
+        pool.parallelFor(numBlocks, [&](unsigned int block, unsigned int) {
+            unsigned int begin = block * blockSize;
+            unsigned int end = std::min<size_t>(begin + blockSize, live.size());
+
+            kept[block].clear();
+            for (unsigned int i = begin; i < end; i++) {
+                unsigned int e = live[i];
+                if (component[edgeData[e].source] != component[edgeData[e].destination]) {
+                    kept[block].push_back(e);
+                }
+            }
+        });
+
+        live.clear();
+        for (unsigned b = 0; b < numBlocks; b++) {
+            live.insert(live.end(), kept[b].begin(), kept[b].end());
+        }
+    }
+
+    // Edges are chosen a round at a time, so the cost is summed once the
+    // tree is complete, lightest first as Kruskal's algorithm sums it, for
+    // every algorithm to return the same cost to the last bit
+    std::sort(treeOrders.begin(), treeOrders.end(), lighter);
+    double minCost = 0;
+    for (unsigned i = 0; i < treeOrders.size(); i++) {
+        treeEdges[i] = edgeData[treeOrders[i]];
+        minCost = minCost + treeEdges[i].weight;
+    }
+    treeCost = minCost;
+    return minCost;
+}
+
+/// \brief
+///
+/// Calculates the minimum spanning tree cost of the complete graph over
+/// the vertex coordinates weighted by straight line distance, through
+/// Kruskal's algorithm on the O(N) edges of their Delaunay triangulation
+/// \pre - coordinates set for all vertices
+/// \return double - minimum spanning tree cost
+double Graph::euclideanMinimumSpanningTreeCost(){
+
+    // The Euclidean minimum spanning tree only uses edges of the
+    // Delaunay triangulation, so those are the only candidates
+    clearTree();
+    std::vector<WeightedEdge> candidates;
+    Delaunay delaunay;
+    delaunay.triangulate(coordinateData, numVertices, candidates);
+
+    std::vector<unsigned int> order(candidates.size());
+    for (unsigned int e = 0; e < order.size(); e++) order[e] = e;
+    LighterEdge lighter = { candidates.data() };
+    std::sort(order.begin(), order.end(), lighter);
+
+    double minCost = 0;
+    DisjointSet ds = DisjointSet(numVertices);
+    unsigned int edgeCount = 0;
+
+    for (unsigned int i = 0; i < order.size() && edgeCount + 1 < numVertices; i++) {
+        if (addTreeEdge(candidates[order[i]], order[i], ds, minCost)) {
+            edgeCount++;
+        }
+    }
+
+    // The tree spans the straight line edges rather than the edge list,
+    // whose indices its ties are not broken by, so added edges leave it be
+    treeMaintained = false;
+    return minCost;
+}
+
+/// \brief
+///
+/// Calculates part of the minimum spanning tree through filter-Kruskal,
+/// the edges are partitioned around a pivot weight, the lighter part is
+/// processed first and the heavier part is then stripped of the edges
+/// that have fallen inside a component before it is processed in turn
+/// \param unsigned int* begin - first of the edge indices to process
+/// \param unsigned int* end - one past the last edge index to process
+/// \param DisjointSet& ds - components joined so far
+/// \param unsigned int& edgeCount - number of tree edges so far
+/// \param double& minCost - cost of the tree edges so far
+void Graph::filterKruskal(unsigned int* begin, unsigned int* end, DisjointSet& ds,
+                          unsigned int& edgeCount, double& minCost){
+
+    LighterEdge lighter = { edges };
+
+    // Small partitions are sorted and scanned as in Kruskal's algorithm
+    if (end - begin <= FILTER_THRESHOLD) {
+        std::sort(begin, end, lighter);
+        for (unsigned int* e = begin; e != end && edgeCount + 1 < numVertices; e++) {
+            if (addTreeEdge(edges[*e], *e, ds, minCost)) {
+                edgeCount++;
+            }
+        }
+        return;
+    }
+
+    // The median of three edges as pivot leaves at least
+    // one edge on each side, so both parts are smaller
+    unsigned int a = *begin;
+    unsigned int b = begin[(end - begin) / 2];
+    unsigned int c = *(end - 1);
+    unsigned int pivot;
+    if (lighter(a, b)) {
+        pivot = lighter(b, c) ? b : (lighter(a, c) ? c : a);
+    } else {
+        pivot = lighter(a, c) ? a : (lighter(b, c) ? c : b);
+    }
+
+    unsigned int* middle = std::partition(begin, end, [&](unsigned int e) {
+        return !lighter(pivot, e);
+    });
+
+    filterKruskal(begin, middle, ds, edgeCount, minCost);
+    if (edgeCount + 1 >= numVertices) return;
+
+    // Heavier edges joining vertices the lighter ones already
+    // connected can never be in the tree, so are never sorted
+    unsigned int* kept = std::partition(middle, end, [&](unsigned int e) {
+        return !ds.sameComponent(edges[e].source, edges[e].destination);
+    });
+    GRAPH_STATS_COUNT(EDGES_SCANNED, end - middle);
+    GRAPH_STATS_COUNT(EDGES_REJECTED, end - kept);
+
+    filterKruskal(middle, kept, ds, edgeCount, minCost);
+}
+
+/// \brief
+///
+/// Adds an edge to the minimum spanning tree if its end points are
+/// in different components, joining them and recording the adjacency
+/// \param const WeightedEdge& e - edge to be added
+/// \param unsigned int order - index of the edge among the candidates
+/// \param DisjointSet& ds - components joined so far
+/// \param double& minCost - cost of the tree edges so far
+/// \return bool - true if the edge was added
+bool Graph::addTreeEdge(const WeightedEdge& e, unsigned int order, DisjointSet& ds, double& minCost){
+    int p = e.source;
+    int q = e.destination;
+    GRAPH_STATS_COUNT(EDGES_SCANNED, 1);
+    if (ds.sameComponent(p, q)) {
+        GRAPH_STATS_COUNT(EDGES_REJECTED, 1);
+        return false;
+    }
+
+    ds.join(p, q);
+    recordTreeEdge(e, order);
+    minCost = minCost + e.weight;
+    return true;
+}
+
+/// \brief
+///
+/// Records an edge chosen for the minimum spanning tree, in the
+/// adjacencies of its end points and the tree's edges and cost
+/// \param const WeightedEdge& e - edge chosen
+/// \param unsigned int order - index of the edge among the candidates
+void Graph::recordTreeEdge(const WeightedEdge& e, unsigned int order){
+    vertices.at(e.source).addAdjacency(e.destination);
+    vertices.at(e.destination).addAdjacency(e.source);
+    treeEdges.push_back(e);
+    treeOrders.push_back(order);
+    treeCost = treeCost + e.weight;
+    forestStale = true;
+    treeAdjacencyStale = true;
+}
+
+/// \brief
+///
+/// Inserts an edge added to the graph into the minimum spanning tree,
+/// joining two trees of the forest, or replacing the heaviest edge on
+/// the path between its end points if the edge is lighter
+/// \param const WeightedEdge& e - edge added
+/// \param unsigned int order - index of the edge in the edge list
+void Graph::insertTreeEdge(const WeightedEdge& e, unsigned int order){
+
+    if (forestStale) {
+        buildForest();
+    }
+
+    unsigned int u = e.source;
+    unsigned int v = e.destination;
+    if (u == v) return;
+
+    // An edge joining two trees of the forest always belongs to the
+    // tree, and takes the next free node after the vertices
+    unsigned int slot;
+    if (!forest.connected(u, v)) {
+        slot = treeEdges.size();
+        treeEdges.push_back(e);
+        treeOrders.push_back(order);
     } else {
-        std::cout << "Distance from ";
-        std::cout << source << " to  " << destination;
-        std::cout << " = " << std::setw(6) << distance;
-        std::cout << " traveling via  " << path << std::endl;
+
+        // Otherwise the edge closes a cycle, by the cycle property the
+        // heaviest edge of which is in no minimum spanning tree. Later
+        // edges are heavier than earlier ones of the same weight, so the
+        // tree is the one every algorithm would calculate from scratch
+        unsigned int heaviest = forest.pathMaximum(u, v);
+        slot = heaviest - numVertices;
+        WeightedEdge& replaced = treeEdges[slot];
+        if (e.weight > replaced.weight || (e.weight == replaced.weight && order > treeOrders[slot])) return;
+
+        forest.cut(replaced.source, heaviest);
+        forest.cut(heaviest, replaced.destination);
+        vertices.at(replaced.source).removeAdjacency(replaced.destination);
+        vertices.at(replaced.destination).removeAdjacency(replaced.source);
+        treeCost = treeCost - replaced.weight;
+        replaced = e;
+        treeOrders[slot] = order;
     }
+
+    unsigned int node = numVertices + slot;
+    forest.setKey(node, e.weight, order);
+    forest.link(node, u);
+    forest.link(v, node);
+    vertices.at(u).addAdjacency(v);
+    vertices.at(v).addAdjacency(u);
+    treeCost = treeCost + e.weight;
+    treeAdjacencyStale = true;
 }
 
 /// \brief
 ///
-/// Simple int to string conversion method
-/// Used to create the path string within the algorithm method
-/// \param int - an integer
-/// \return string - representation of integer
-std::string Graph::convertIntToString(int i){
-    std::stringstream ss;
-    ss << i;
-    return ss.str();
+/// Builds the link-cut forest from the edges of the minimum spanning
+/// tree in linear time, hanging every tree from its lowest vertex
+void Graph::buildForest(){
+
+    // A forest over N vertices has fewer than N edges, so a node
+    // is kept for every edge the tree could ever hold
+    forest.reset(2 * numVertices);
+
+    // List the tree edges at each vertex, by their slots
+    std::vector<unsigned int> offsets(numVertices + 1, 0);
+    for (unsigned int t = 0; t < treeEdges.size(); t++) {
+        offsets[treeEdges[t].source + 1]++;
+        offsets[treeEdges[t].destination + 1]++;
+    }
+    for (unsigned int v = 0; v < numVertices; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+    std::vector<unsigned int> slots(offsets[numVertices]);
+    std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+    for (unsigned int t = 0; t < treeEdges.size(); t++) {
+        slots[cursor[treeEdges[t].source]++] = t;
+        slots[cursor[treeEdges[t].destination]++] = t;
+    }
+
+    // Walk each tree breadth first, every edge node hanging
+    // below the vertex reached first and above the other
+    std::vector<char> reached(numVertices, 0);
+    std::vector<unsigned int> queue;
+    for (unsigned int root = 0; root < numVertices; root++) {
+        if (reached[root]) continue;
+        reached[root] = 1;
+        queue.assign(1, root);
+        for (size_t head = 0; head < queue.size(); head++) {
+            unsigned int u = queue[head];
+            for (unsigned int i = offsets[u]; i < offsets[u + 1]; i++) {
+                unsigned int t = slots[i];
+                const WeightedEdge& e = treeEdges[t];
+                unsigned int v = e.source == u ? e.destination : e.source;
+                if (reached[v]) continue;
+                reached[v] = 1;
+
+                unsigned int node = numVertices + t;
+                forest.setKey(node, e.weight, treeOrders[t]);
+                forest.attach(node, u);
+                forest.attach(v, node);
+                queue.push_back(v);
+            }
+        }
+    }
+    forestStale = false;
+}
+
+/// \brief
+///
+/// Removes the minimum spanning tree of an earlier call from the
+/// adjacency lists of the vertices, ready for a new tree to be
+/// calculated and then kept up to date as edges are added
+void Graph::clearTree(){
+    for (unsigned i = 0; i < vertices.size(); i++) {
+        vertices[i].clearAdjacencies();
+    }
+    treeEdges.clear();
+    treeOrders.clear();
+    treeCost = 0;
+    treeMaintained = true;
+    forestStale = true;
+    treeAdjacencyStale = true;
 }
+
+/// \brief
+///
+/// Helper method for outputting the path from the source of a
+/// tree to a vertice and the distance covered by the path
+/// \param ShortestPathTree& tree - tree filled by a search
+/// \param unsigned int destination - destination vertex ID
+/// \param vector<unsigned int>& path - collection reused to hold the path
+/// \param OutputWriter& writer - writer to output to
+void Graph::outputPath(ShortestPathTree& tree, unsigned int destination, std::vector<unsigned int>& path,
+                       OutputWriter& writer){
+
+    unsigned int source = tree.getSource();
+    double distance = tree.getDistance(destination);
+
+    if (distance == INFINITY) {
+        writer.write("NO PATH  from ");
+        writer.writeInteger(source);
+        writer.write(" to  ");
+        writer.writeInteger(destination);
+        writer.write('\n');
+    } else {
+        writer.write("Distance from ");
+        writer.writeInteger(source);
+        writer.write(" to  ");
+        writer.writeInteger(destination);
+        writer.write(" = ");
+        writer.writeFixed(distance, 2, 6);
+        writer.write(" traveling via  ");
+        tree.pathTo(destination, path);
+        for (unsigned i = 0; i < path.size(); i++) {
+            writer.writeInteger(path[i]);
+            writer.write("  ", 2);
+        }
+        writer.write('\n');
+    }
+}
+
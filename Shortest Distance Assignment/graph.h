@@ -9,90 +9,403 @@
 
 #include <vector>
 #include <queue>
+#include <cmath>
 
 #ifndef _graph_
 #define _graph_
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 
 #include "vertex.h"
 #include "edge.h"
 #include "disjointset.h"
+#include "compressedsparserow.h"
+#include "indexedheap.h"
+#include "point.h"
+#include "querycontext.h"
+#include "shortestpathtree.h"
+#include "outputwriter.h"
+#include "graphfile.h"
+#include "graphstats.h"
+#include "linkcuttree.h"
+
+// <cmath> defines INFINITY as a macro for the floating point infinity,
+// it is included above and the macro removed so the constant below is used
+#ifdef INFINITY
+#undef INFINITY
+#endif
 
 // Constant representing infinity
 const int INFINITY = 9999999;
 
+// Algorithms available for calculating the minimum spanning tree,
+// Kruskal's on one thread, filter-Kruskal which skips sorting edges
+// that end up inside a component, Boruvka's across a pool of threads, or
+// Kruskal's over the Delaunay triangulation of the vertex coordinates
+// for the tree of the complete graph weighted by straight line distance
+enum MstAlgorithm { KRUSKAL, FILTER_KRUSKAL, BORUVKA, EUCLIDEAN };
+
 /// Encapsulates instance variables to emulate a graph;
-/// the number of vertices in the graph, a 2-dimensional array
-/// to emulate an adjacency matrix, a queue collection to store edges and
-/// a set collection to store pointers to vertices.
+/// the number of vertices in the graph, a compressed sparse row
+/// adjacency store built from the flat list of added edges, the order of
+/// those edges by weight and a vector collection owning the vertices.
 /// Also includes methods for calculating the minimim spanning tree cost,
 /// and shortest distances from vertices towards a source through dijksta's
-/// algorithm and breadth width search
+/// algorithm and breadth width search. The working state of each search is
+/// kept in a query context, so once all edges are added any number of threads
+/// can search the graph at once, each with its own context
 class Graph {
     public:
 
         /// \brief
         ///
-        /// Constructor, initializes the number of vertices in the graph
-        /// and the adjacency matrix
+        /// Constructor, initializes the number of vertices in the graph,
+        /// the adjacency store stays empty until edges are added
         /// \param unsigned int - number of vertices
         Graph(unsigned int);
 
         /// \brief
         ///
-        /// Destructor, deletes the adjacency matrix and collections
+        /// Destructor, the adjacency store and collections clean up after themselves
         ~Graph();
 
         /// \brief
         ///
-        /// Adds vertices to the graph's vertices collection
+        /// Adds a copy of a vertex to the graph's vertices collection,
+        /// the graph does not keep the pointer so the caller still owns the vertex
         /// \param Vertex* - pointer to the vertex to be added
         void addVertex(Vertex*);
 
         /// \brief
         ///
-        /// Getter for a vertex at a specified identifier/index
+        /// Creates the vertices for every identifier from the number already
+        /// in the vertices collection up to a count, all in one contiguous block
+        /// \param unsigned int - number of vertices the collection is to hold
+        void reserveVertices(unsigned int);
+
+        /// \brief
+        ///
+        /// Getter for a vertex at a specified identifier/index, the pointer
+        /// stays valid until more vertices are added
         /// \param int - identifier/index
         /// \return Vertex* - pointer to the vertex
         Vertex* getVertex(int);
 
         /// \brief
         ///
-        /// Adds vertices to the graph's edge queue collection
+        /// Simple getter for the number of vertices in the graph
+        /// \return unsigned int - number of vertices
+        unsigned int getNumVertices();
+
+        /// \brief
+        ///
+        /// Getter for the adjacency store, rebuilt first if edges
+        /// have been added since it was last built
+        /// \return CompressedSparseRow& - reference to the adjacency store
+        CompressedSparseRow& getAdjacency();
+
+        /// \brief
+        ///
+        /// Adds an edge to the graph's edge list, the adjacency store is rebuilt
+        /// from the list before the next search and the edges resorted before the
+        /// next minimum spanning tree. The graph records the edge by its end point
+        /// IDs and does not keep the pointer, so the caller still owns the edge
         /// \param Edge* - pointer to edge
         void addEdge(Edge*);
 
         /// \brief
         ///
-        /// Calculates the minimum spanning tree cost using the edge queue collection
-        /// through Kruskals Algorithm
-        /// Also sets up the adjacency list for vertices in the graph
-        /// \pre - all edges have added to edges queue collection
+        /// Adds an edge between two vertices to the graph's edge list
+        /// \param unsigned int source - source vertex's ID
+        /// \param unsigned int destination - destination vertex's ID
+        /// \param double weight - weight of the edge
+        void addEdge(unsigned int source, unsigned int destination, double weight);
+
+        /// \brief
+        ///
+        /// Adds many edges to the graph's edge list at once, copied in order
+        /// \pre - the edges are not held by this graph
+        /// \param const WeightedEdge* added - first edge to be added
+        /// \param unsigned int count - number of edges
+        void addEdges(const WeightedEdge* added, unsigned int count);
+
+        /// \brief
+        ///
+        /// Uses the edges, adjacency and coordinates held in an open graph file
+        /// as the graph's storage in place of copies, replacing any edges and
+        /// coordinates added before. Adding edges or setting coordinates later
+        /// copies them out of the file first
+        /// \pre - the graph was constructed with the file's number of vertices
+        /// \pre - the file stays open while the graph uses it
+        /// \param GraphFile& file - open graph file
+        void useFile(GraphFile& file);
+
+        /// \brief
+        ///
+        /// Calculates the minimum spanning tree cost using the edge list
+        /// through Kruskals Algorithm, the edges are sorted once and the order
+        /// kept until more are added, the edge list itself is left unchanged
+        /// Also sets up the adjacency list for vertices in the graph,
+        /// replacing the tree of any earlier call
+        /// \pre - all edges have been added
         /// \param double - minimum spanning tree cost
         double minimumSpanningTreeCost();
 
+        /// \brief
+        ///
+        /// Calculates the minimum spanning tree cost using the specified algorithm,
+        /// ties between equal weights are broken by the order edges were added
+        /// so every algorithm selects the same tree when the weights are distinct
+        /// Also sets up the adjacency list for vertices in the graph,
+        /// replacing the tree of any earlier call
+        /// \pre - all edges have been added, or for EUCLIDEAN coordinates set
+        /// for all vertices, without which the added edges are used instead
+        /// \param MstAlgorithm algorithm - algorithm to use
+        /// \param unsigned int numThreads - number of threads for parallel
+        /// algorithms, 0 for one per hardware thread
+        /// \return double - minimum spanning tree cost
+        double minimumSpanningTreeCost(MstAlgorithm algorithm, unsigned int numThreads);
+
+        /// \brief
+        ///
+        /// Simple getter for the cost of the minimum spanning tree. Once a tree
+        /// has been calculated from the edge list, every edge added after is
+        /// inserted into it, replacing the heaviest edge of the cycle it closes
+        /// if lighter, or joining two trees of the forest, in amortized O(log N)
+        /// time. A tree over the coordinates (EUCLIDEAN) is left as calculated
+        /// \return double - cost of the tree, 0 if none has been calculated
+        double getSpanningTreeCost();
+
+        /// \brief
+        ///
+        /// Simple getter for the edges of the minimum spanning tree kept up to
+        /// date as edges are added, in no particular order
+        /// \param vector<WeightedEdge>& tree - filled with the edges of the tree
+        void getSpanningTreeEdges(std::vector<WeightedEdge>& tree);
+
         /// \brief
         ///
         /// Calculates and outputs the minimum distance and path
         /// between all vertices towards a specified source using Dijkstra's algorithm
-        /// \pre - adjacency matrix initialized
         /// \pre - all vertices have been added to the vertices collection
         /// \param unsigned int - source vertex's ID
         void dijkstra(unsigned int);
 
+        /// \brief
+        ///
+        /// Calculates the minimum distance and path from a source vertex
+        /// to every vertex using Dijkstra's algorithm
+        /// \param unsigned int source - source vertex's ID
+        /// \param ShortestPathTree& tree - filled with the distances and paths
+        void shortestPaths(unsigned int source, ShortestPathTree& tree);
+
         /// \brief
         ///
         /// Calculates and outputs the minimum distance and path
         /// between all vertices towards a specified source through
         /// Breadth Width Search
-        /// \pre - adjacency matrix initialized
         /// \pre - all vertices have been added to the vertices collection
         /// \pre - adjacencies of vertices initialized by MST
         /// \param unsigned int - source vertex's ID
         void bfs(unsigned int);
 
+        /// \brief
+        ///
+        /// Finds the path from a source vertex to every vertex along the
+        /// edges of the minimum spanning tree through breadth first search,
+        /// and the distance covered by each, from the weights of the tree edges
+        /// \pre - adjacencies of vertices initialized by MST
+        /// \param unsigned int source - source vertex's ID
+        /// \param ShortestPathTree& tree - filled with the distances and paths
+        void breadthFirstPaths(unsigned int source, ShortestPathTree& tree);
+
+        /// \brief
+        ///
+        /// Outputs the distance and path from the source of a tree to every
+        /// other vertex, one line per vertex in order of ID
+        /// \param ShortestPathTree& tree - tree filled by a search
+        void outputPaths(ShortestPathTree& tree);
+
+        /// \brief
+        ///
+        /// Outputs the distance and path from the source of a tree to every
+        /// other vertex, one line per vertex in order of ID, through a writer
+        /// \param ShortestPathTree& tree - tree filled by a search
+        /// \param OutputWriter& writer - writer to output to
+        void outputPaths(ShortestPathTree& tree, OutputWriter& writer);
+
+        /// \brief
+        ///
+        /// Calculates the minimum distance and path from a source vertex
+        /// to a single target vertex using Dijkstra's algorithm, stopping
+        /// as soon as the target is settled
+        /// \param unsigned int source - source vertex's ID
+        /// \param unsigned int target - target vertex's ID
+        /// \param vector<unsigned int>& path - filled with the vertex IDs
+        /// from source to target, left empty if there is no path
+        /// \return double - distance of the path, INFINITY if there is no path
+        double shortestPath(unsigned int source, unsigned int target, std::vector<unsigned int>& path);
+
+        /// \brief
+        ///
+        /// Calculates the minimum distance and path from a source vertex
+        /// to a single target vertex using Dijkstra's algorithm, stopping
+        /// as soon as the target is settled
+        /// \param unsigned int source - source vertex's ID
+        /// \param unsigned int target - target vertex's ID
+        /// \param vector<unsigned int>& path - filled with the vertex IDs
+        /// from source to target, left empty if there is no path
+        /// \param QueryContext& context - context holding the working state of the search
+        /// \return double - distance of the path, INFINITY if there is no path
+        double shortestPath(unsigned int source, unsigned int target, std::vector<unsigned int>& path,
+                            QueryContext& context);
+
+        /// \brief
+        ///
+        /// Calculates the minimum distance and path from a source vertex
+        /// to a single target vertex by running Dijkstra's algorithm from
+        /// both ends at once, stopping when the two searches meet
+        /// \param unsigned int source - source vertex's ID
+        /// \param unsigned int target - target vertex's ID
+        /// \param vector<unsigned int>& path - filled with the vertex IDs
+        /// from source to target, left empty if there is no path
+        /// \return double - distance of the path, INFINITY if there is no path
+        double bidirectionalShortestPath(unsigned int source, unsigned int target, std::vector<unsigned int>& path);
+
+        /// \brief
+        ///
+        /// Calculates the minimum distance and path from a source vertex
+        /// to a single target vertex by running Dijkstra's algorithm from
+        /// both ends at once, stopping when the two searches meet
+        /// \param unsigned int source - source vertex's ID
+        /// \param unsigned int target - target vertex's ID
+        /// \param vector<unsigned int>& path - filled with the vertex IDs
+        /// from source to target, left empty if there is no path
+        /// \param QueryContext& context - context holding the working state of the search
+        /// \return double - distance of the path, INFINITY if there is no path
+        double bidirectionalShortestPath(unsigned int source, unsigned int target, std::vector<unsigned int>& path,
+                                         QueryContext& context);
+
+        /// \brief
+        ///
+        /// Calculates the minimum distances from each of a list of source vertices
+        /// to every vertex using Dijkstra's algorithm, running the sources in
+        /// parallel across a pool of threads with separate working state per thread
+        /// \param const vector<unsigned int>& sources - source vertices' IDs
+        /// \param unsigned int numThreads - number of threads, 0 for one per hardware thread
+        /// \param vector<double>& distances - filled with one row per source of the
+        /// distance to every vertex, INFINITY for those that cannot be reached
+        /// \param vector<unsigned int>* predecessors - filled with one row per source
+        /// of the vertex preceding every vertex on its path, the vertex itself for the
+        /// source and those that cannot be reached, or NULL if not needed
+        void multiSourceShortestPaths(const std::vector<unsigned int>& sources, unsigned int numThreads,
+                                      std::vector<double>& distances, std::vector<unsigned int>* predecessors);
+
+        /// \brief
+        ///
+        /// Calculates the minimum distance and path from a source vertex to
+        /// every vertex through delta-stepping, which settles the vertices in
+        /// buckets of distances delta wide rather than one at a time. The edges
+        /// of each bucket's vertices are relaxed in parallel, those no heavier
+        /// than delta repeatedly until the bucket stays empty and the heavier
+        /// ones once after. The distances are the same as Dijkstra's algorithm
+        /// finds, and each vertex's predecessor is the first vertex along its
+        /// adjacencies from which its distance is reached
+        /// \param unsigned int source - source vertex's ID
+        /// \param ShortestPathTree& tree - filled with the distances and paths
+        /// \param double delta - width of the buckets, 0 to choose one from the
+        /// edge weights
+        /// \param unsigned int numThreads - number of threads, 0 for one per hardware thread
+        void deltaSteppingShortestPaths(unsigned int source, ShortestPathTree& tree, double delta,
+                                        unsigned int numThreads);
+
+        /// \brief
+        ///
+        /// Calculates the minimum distance and path from a source vertex to
+        /// every vertex using Dijkstra's algorithm, and keeps them up to date
+        /// as edges are added or made lighter, propagating each change only
+        /// to the vertices whose distances improve, until another source is
+        /// maintained or a graph file is used
+        /// \param unsigned int source - source vertex's ID
+        void maintainShortestPaths(unsigned int source);
+
+        /// \brief
+        ///
+        /// Simple getter for the shortest path tree kept up to date
+        /// \pre - a source is maintained
+        /// \return ShortestPathTree& - reference to the tree
+        ShortestPathTree& getMaintainedPaths();
+
+        /// \brief
+        ///
+        /// Lowers the weight of the lightest edge between two vertices in
+        /// place, if the new weight is lower, repairing a minimum spanning
+        /// tree or shortest path tree kept up to date from that edge alone
+        /// \param unsigned int source - source vertex's ID
+        /// \param unsigned int destination - destination vertex's ID
+        /// \param double weight - new weight of the edge
+        /// \return bool - true if the edge exists and was made lighter
+        bool decreaseWeight(unsigned int source, unsigned int destination, double weight);
+
+        /// \brief
+        ///
+        /// Stores the coordinates of a vertex, packed with those of the
+        /// other vertices, so they can guide the A* search
+        /// \param unsigned int id - vertex's ID
+        /// \param Point* point - pointer to the vertex's location
+        void setCoordinates(unsigned int id, Point* point);
+
+        /// \brief
+        ///
+        /// Calculates the minimum distance and path from a source vertex
+        /// to a single target vertex using the A* algorithm, ordering the
+        /// search by distance travelled plus straight line distance remaining
+        /// \pre - coordinates set for all vertices, or for none in which case
+        /// the search is equivalent to shortestPath
+        /// \pre - edge weights are at least the straight line distance
+        /// between their end points
+        /// \param unsigned int source - source vertex's ID
+        /// \param unsigned int target - target vertex's ID
+        /// \param vector<unsigned int>& path - filled with the vertex IDs
+        /// from source to target, left empty if there is no path
+        /// \return double - distance of the path, INFINITY if there is no path
+        double aStar(unsigned int source, unsigned int target, std::vector<unsigned int>& path);
+
+        /// \brief
+        ///
+        /// Calculates the minimum distance and path from a source vertex
+        /// to a single target vertex using the A* algorithm, ordering the
+        /// search by distance travelled plus straight line distance remaining
+        /// \pre - coordinates set for all vertices, or for none in which case
+        /// the search is equivalent to shortestPath
+        /// \pre - edge weights are at least the straight line distance
+        /// between their end points
+        /// \param unsigned int source - source vertex's ID
+        /// \param unsigned int target - target vertex's ID
+        /// \param vector<unsigned int>& path - filled with the vertex IDs
+        /// from source to target, left empty if there is no path
+        /// \param QueryContext& context - context holding the working state of the search
+        /// \return double - distance of the path, INFINITY if there is no path
+        double aStar(unsigned int source, unsigned int target, std::vector<unsigned int>& path,
+                     QueryContext& context);
+
+        /// \brief
+        ///
+        /// Gathers the work counted by the searches, disjoint sets and minimum
+        /// spanning trees of every thread and every graph since the last reset,
+        /// all zero unless the program is compiled with GRAPH_STATS defined
+        /// \return GraphStats - totals of the counters
+        static GraphStats getStats();
+
+        /// \brief
+        ///
+        /// Starts the counters again from zero
+        static void resetStats();
+
         /// \brief
         ///
         /// Ostream operator overload
@@ -101,34 +414,205 @@ class Graph {
         /// \param Graph& - reference to graph
         friend std::ostream& operator<<(std::ostream&, Graph&);
 
+        /// \brief
+        ///
+        /// Outputs the adjacency matrix through a writer, one row per
+        /// line with a dash where two vertices are not adjacent
+        /// \param OutputWriter& - writer to output to
+        void outputMatrix(OutputWriter&);
+
     private:
 
         // Instance variables encapsulating the number of vertices
-        // in the graphs, the adjacency matrix, edges queue collection
-        // and vector collection
+        // in the graphs, the list of added edges, the edges in use and their
+        // number, either that list or a graph file's, the adjacency store built
+        // from them and whether it is out of date, the edge indices
+        // sorted by weight and whether they are out of date, and the vertices
+        // collection, with a lock guarding rebuilds of the adjacency store
         unsigned int numVertices;
-        double** weights;
-        std::priority_queue<Edge*, std::vector<Edge*>, Edge> edges;
-        std::vector<Vertex*> vertices;
+        std::vector<WeightedEdge> edgeList;
+        const WeightedEdge* edges;
+        unsigned int numEdges;
+        CompressedSparseRow adjacency;
+        std::atomic<bool> adjacencyStale;
+        std::mutex adjacencyMutex;
+        std::vector<unsigned int> sortedEdges;
+        bool sortedStale;
+        std::vector<Vertex> vertices;
+
+        // Instance variables storing the x and y coordinates of
+        // every vertex in pairs, empty unless coordinates are set, and
+        // the coordinates in use, either those or a graph file's, NULL if none
+        std::vector<double> coordinates;
+        const double* coordinateData;
+
+        // Instance variable holding the working state of
+        // searches called without a context of their own
+        QueryContext context;
+
+        // Instance variables storing the edges of the minimum spanning tree,
+        // with the index among the candidates of each, which breaks ties
+        // between equal weights, the tree's cost, whether the tree was
+        // calculated from the edge list and so is kept up to date, and a
+        // link-cut forest of the tree with a node per vertex followed by a
+        // node per tree edge, built from the edges when the first edge is
+        // inserted and while out of date, and an adjacency store of the
+        // tree edges for breadth first search, rebuilt while out of date
+        std::vector<WeightedEdge> treeEdges;
+        std::vector<unsigned int> treeOrders;
+        double treeCost;
+        bool treeMaintained;
+        bool forestStale;
+        LinkCutTree forest;
+        CompressedSparseRow treeAdjacency;
+        bool treeAdjacencyStale;
+
+        // Instance variables storing the shortest path tree kept up to date
+        // as edges are added, whether one is kept, and the edges added since
+        // the adjacency store was built, from the first of them, each chained
+        // from both end points through a slot per end point
+        ShortestPathTree pathTree;
+        bool pathsMaintained;
+        unsigned int firstPending;
+        std::vector<unsigned int> pendingHead;
+        std::vector<unsigned int> pendingNext;
+
+        /// \brief
+        ///
+        /// Rebuilds the adjacency store from the edge list if edges have been
+        /// added since it was last built, under a lock so searches started
+        /// together on several threads only rebuild it once
+        void updateAdjacency();
+
+        /// \brief
+        ///
+        /// Empties the chains of edges added since the adjacency store was
+        /// built, after it is rebuilt or a source starts being maintained
+        void clearPending();
+
+        /// \brief
+        ///
+        /// Repairs the maintained shortest path tree after edges are added,
+        /// chaining each added edge from its end points, then lowering the
+        /// distances across them and settling the vertices lowered
+        /// \param unsigned int first - index of the first edge added
+        void repairShortestPaths(unsigned int first);
+
+        /// \brief
+        ///
+        /// Lowers the distance of either end point of an edge in the
+        /// maintained shortest path tree if the edge leads to it on a
+        /// shorter path, queueing the end point lowered
+        /// \param const WeightedEdge& e - edge added or made lighter
+        void lowerAcross(const WeightedEdge& e);
+
+        /// \brief
+        ///
+        /// Settles the vertices queued in the maintained shortest path tree
+        /// in distance order, as Dijkstra's algorithm does, so only they and
+        /// their edges are visited
+        void settleLowered();
+
+        /// \brief
+        ///
+        /// Appends the path ending at a vertex to a path collection by
+        /// walking a predecessor array back to the start of the search
+        /// \param unsigned int end - last vertex of the path
+        /// \param const vector<unsigned int>& predecessor - predecessor array to walk
+        /// \param vector<unsigned int>& path - collection the path is appended to
+        void appendPath(unsigned int end, const std::vector<unsigned int>& predecessor, std::vector<unsigned int>& path);
+
+        /// \brief
+        ///
+        /// Calculates the minimum spanning tree cost through Boruvka's algorithm,
+        /// each round finds the lightest edge leaving every component in parallel
+        /// and joins the components along those edges
+        /// \param unsigned int numThreads - number of threads, 0 for one per hardware thread
+        /// \return double - minimum spanning tree cost
+        double boruvka(unsigned int numThreads);
+
+        /// \brief
+        ///
+        /// Chooses the bucket width for delta-stepping, the heaviest edge
+        /// weight divided by the average degree as Meyer and Sanders suggest,
+        /// so that most edges are light while buckets stay narrow
+        /// \return double - bucket width, greater than 0
+        double defaultDelta();
+
+        /// \brief
+        ///
+        /// Calculates part of the minimum spanning tree through filter-Kruskal,
+        /// the edges are partitioned around a pivot weight, the lighter part is
+        /// processed first and the heavier part is then stripped of the edges
+        /// that have fallen inside a component before it is processed in turn
+        /// \param unsigned int* begin - first of the edge indices to process
+        /// \param unsigned int* end - one past the last edge index to process
+        /// \param DisjointSet& ds - components joined so far
+        /// \param unsigned int& edgeCount - number of tree edges so far
+        /// \param double& minCost - cost of the tree edges so far
+        void filterKruskal(unsigned int* begin, unsigned int* end, DisjointSet& ds,
+                           unsigned int& edgeCount, double& minCost);
+
+        /// \brief
+        ///
+        /// Adds an edge to the minimum spanning tree if its end points are
+        /// in different components, joining them and recording the adjacency
+        /// \param const WeightedEdge& e - edge to be added
+        /// \param unsigned int order - index of the edge among the candidates
+        /// \param DisjointSet& ds - components joined so far
+        /// \param double& minCost - cost of the tree edges so far
+        /// \return bool - true if the edge was added
+        bool addTreeEdge(const WeightedEdge& e, unsigned int order, DisjointSet& ds, double& minCost);
+
+        /// \brief
+        ///
+        /// Records an edge chosen for the minimum spanning tree, in the
+        /// adjacencies of its end points and the tree's edges and cost
+        /// \param const WeightedEdge& e - edge chosen
+        /// \param unsigned int order - index of the edge among the candidates
+        void recordTreeEdge(const WeightedEdge& e, unsigned int order);
+
+        /// \brief
+        ///
+        /// Inserts an edge added to the graph into the minimum spanning tree,
+        /// joining two trees of the forest, or replacing the heaviest edge on
+        /// the path between its end points if the edge is lighter
+        /// \param const WeightedEdge& e - edge added
+        /// \param unsigned int order - index of the edge in the edge list
+        void insertTreeEdge(const WeightedEdge& e, unsigned int order);
+
+        /// \brief
+        ///
+        /// Builds the link-cut forest from the edges of the minimum spanning
+        /// tree in linear time, hanging every tree from its lowest vertex
+        void buildForest();
+
+        /// \brief
+        ///
+        /// Removes the minimum spanning tree of an earlier call from the
+        /// adjacency lists of the vertices, ready for a new tree to be
+        /// calculated and then kept up to date as edges are added
+        void clearTree();
 
         /// \brief
         ///
-        /// Helper method for outputting the path from source point to
-        /// a vertice and the distance covered by the path
-        /// \pre path strings prepared by the algorithm methods
-        /// \param int source - source vertex ID
-        /// \param int destination - destination vertex ID
-        /// \param double distance - distance covered by the path
-        /// \param string path - string representation of the path
-        void outputPath(int source, int destination, double distance, std::string path);
+        /// Calculates the minimum spanning tree cost of the complete graph over
+        /// the vertex coordinates weighted by straight line distance, through
+        /// Kruskal's algorithm on the O(N) edges of their Delaunay triangulation
+        /// \pre - coordinates set for all vertices
+        /// \return double - minimum spanning tree cost
+        double euclideanMinimumSpanningTreeCost();
 
         /// \brief
         ///
-        /// Simple int to string conversion method
-        /// Used to create the path string within the algorithm method
-        /// \param int - an integer
-        /// \return string - representation of integer
-        std::string convertIntToString(int);
+        /// Helper method for outputting the path from the source of a
+        /// tree to a vertice and the distance covered by the path
+        /// \param ShortestPathTree& tree - tree filled by a search
+        /// \param unsigned int destination - destination vertex ID
+        /// \param vector<unsigned int>& path - collection reused to hold the path
+        /// \param OutputWriter& writer - writer to output to
+        void outputPath(ShortestPathTree& tree, unsigned int destination, std::vector<unsigned int>& path,
+                        OutputWriter& writer);
 
 };
 
@@ -0,0 +1,291 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: graphfile.cpp
+/// Implementation of GraphFile class
+/// Encapsulates a binary graph file mapped into memory,
+/// whose arrays are used in place as a graph's storage
+
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "graphfile.h"
+#include "compressedsparserow.h"
+
+// Constant identifying a graph file, the first bytes of its header
+const char GRAPH_FILE_MAGIC[8] = { 'G', 'R', 'A', 'P', 'H', 'C', 'S', 'R' };
+
+// Constant defining the alignment of every section of a graph file
+const unsigned long long SECTION_ALIGNMENT = 64;
+
+// Constant defining the most edges a file may hold, both ends of every
+// edge have to be counted by the unsigned int row offsets
+const unsigned long long MAX_FILE_EDGES = 0x7FFFFFFF;
+
+// Edges are written and read as they are laid out in memory
+static_assert(sizeof(WeightedEdge) == 16, "WeightedEdge must be two identifiers and a weight");
+
+/// Encapsulates a binary graph file mapped read only into memory. After the
+/// header the file holds the x and y coordinates of every vertex in pairs,
+/// the adjacency in compressed sparse row form and the list of edges in the
+/// order they were added, each array laid out exactly as a graph holds it in
+/// memory. Opening a file maps it and checks the header, the section bounds
+/// and, in one pass over the arrays, that every identifier in them names a
+/// vertex, so a damaged file is rejected rather than read out of bounds
+
+/// \brief
+///
+/// Constructor, initializes a graph file that is not open
+GraphFile::GraphFile(){
+    data = NULL;
+    length = 0;
+}
+
+/// \brief
+///
+/// Destructor, unmaps the file if open
+GraphFile::~GraphFile(){
+    close();
+}
+
+/// \brief
+///
+/// Maps a graph file into memory, closing any file open before
+/// \param const char* fileName - name of the file
+/// \return bool - true if the file was mapped and is a graph file
+/// of this version with every section inside the file and every
+/// identifier in its arrays naming a vertex
+bool GraphFile::open(const char* fileName){
+
+    close();
+
+    int fd = ::open(fileName, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || (unsigned long long) status.st_size < sizeof(GraphFileHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    // The mapping keeps the file alive, so the descriptor is not needed after
+    void* mapped = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+
+    data = (const char*) mapped;
+    length = status.st_size;
+
+    // Check everything later reads is inside the file, then that
+    // every identifier in the arrays names a vertex
+    const GraphFileHeader* header = getHeader();
+    unsigned long long N = header->numVertices;
+    unsigned long long M = header->numEdges;
+    bool valid = std::memcmp(header->magic, GRAPH_FILE_MAGIC, sizeof(GRAPH_FILE_MAGIC)) == 0
+                 && header->version == GRAPH_FILE_VERSION
+                 && header->fileSize == length
+                 && M <= MAX_FILE_EDGES
+                 && (header->coordinatesOffset == 0 || isInside(header->coordinatesOffset, 2 * N * sizeof(double)))
+                 && isInside(header->offsetsOffset, (N + 1) * sizeof(unsigned int))
+                 && isInside(header->targetsOffset, 2 * M * sizeof(unsigned int))
+                 && isInside(header->weightsOffset, 2 * M * sizeof(double))
+                 && isInside(header->edgesOffset, M * sizeof(WeightedEdge));
+
+    if (valid) {
+        const unsigned int* offsets = getOffsets();
+        valid = offsets[0] == 0 && offsets[N] == 2 * M && hasValidIds();
+    }
+
+    if (!valid) {
+        close();
+    }
+    return valid;
+}
+
+/// \brief
+///
+/// Unmaps the file, the arrays must no longer be in use
+void GraphFile::close(){
+    if (data != NULL) {
+        munmap((void*) data, length);
+        data = NULL;
+        length = 0;
+    }
+}
+
+/// \brief
+///
+/// Simple getter for whether a file is open
+/// \return bool - true if open
+bool GraphFile::isOpen(){
+    return data != NULL;
+}
+
+/// \brief
+///
+/// Simple getter for the number of vertices
+/// \return unsigned int - number of vertices
+unsigned int GraphFile::getNumVertices(){
+    return getHeader()->numVertices;
+}
+
+/// \brief
+///
+/// Simple getter for the number of undirected edges
+/// \return unsigned int - number of edges
+unsigned int GraphFile::getNumEdges(){
+    return getHeader()->numEdges;
+}
+
+/// \brief
+///
+/// Simple getter for the coordinates of every vertex in pairs
+/// \return const double* - first x coordinate, NULL if the file has none
+const double* GraphFile::getCoordinates(){
+    unsigned long long offset = getHeader()->coordinatesOffset;
+    return offset == 0 ? NULL : (const double*) (data + offset);
+}
+
+/// \brief
+///
+/// Simple getter for the row offsets of the adjacency, numVertices + 1 of them
+/// \return const unsigned int* - pointer to the first offset
+const unsigned int* GraphFile::getOffsets(){
+    return (const unsigned int*) (data + getHeader()->offsetsOffset);
+}
+
+/// \brief
+///
+/// Simple getter for the neighbour identifiers of the adjacency,
+/// one for both ends of every edge
+/// \return const unsigned int* - pointer to the first neighbour
+const unsigned int* GraphFile::getTargets(){
+    return (const unsigned int*) (data + getHeader()->targetsOffset);
+}
+
+/// \brief
+///
+/// Simple getter for the weights of the adjacency, parallel to the
+/// neighbour identifiers
+/// \return const double* - pointer to the first weight
+const double* GraphFile::getWeights(){
+    return (const double*) (data + getHeader()->weightsOffset);
+}
+
+/// \brief
+///
+/// Simple getter for the list of edges in the order they were added
+/// \return const WeightedEdge* - first edge
+const WeightedEdge* GraphFile::getEdges(){
+    return (const WeightedEdge*) (data + getHeader()->edgesOffset);
+}
+
+/// \brief
+///
+/// Writes a graph file, building the adjacency arrays from the edges
+/// \param const char* fileName - name of the file
+/// \param unsigned int numVertices - number of vertices
+/// \param const double* coordinates - x and y coordinates of every
+/// vertex in pairs, or NULL if there are none
+/// \param const vector<WeightedEdge>& edges - edges in the order added
+/// \return bool - true if the whole file was written
+bool GraphFile::write(const char* fileName, unsigned int numVertices, const double* coordinates,
+                      const std::vector<WeightedEdge>& edges){
+
+    if (edges.size() > MAX_FILE_EDGES) return false;
+
+    CompressedSparseRow adjacency;
+    adjacency.build(numVertices, edges.data(), edges.size());
+
+    unsigned long long N = numVertices;
+    unsigned long long M = edges.size();
+
+    // Lay the sections out one after another, each starting on an aligned offset
+    GraphFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(GRAPH_FILE_MAGIC));
+    header.version = GRAPH_FILE_VERSION;
+    header.numVertices = numVertices;
+    header.numEdges = M;
+
+    const void* sections[5] = { coordinates, adjacency.getOffsets(), adjacency.getTargets(),
+                                adjacency.getWeights(), edges.data() };
+    unsigned long long sizes[5] = { coordinates == NULL ? 0 : 2 * N * sizeof(double),
+                                    (N + 1) * sizeof(unsigned int), 2 * M * sizeof(unsigned int),
+                                    2 * M * sizeof(double), M * sizeof(WeightedEdge) };
+    unsigned long long* offsets[5] = { &header.coordinatesOffset, &header.offsetsOffset, &header.targetsOffset,
+                                       &header.weightsOffset, &header.edgesOffset };
+
+    unsigned long long end = sizeof(header);
+    for (int i = 0; i < 5; i++) {
+        if (i == 0 && coordinates == NULL) continue;
+        end = (end + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+        *offsets[i] = end;
+        end += sizes[i];
+    }
+    header.fileSize = end;
+
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    if (out.fail()) return false;
+
+    out.write((const char*) &header, sizeof(header));
+    unsigned long long written = sizeof(header);
+    const char padding[SECTION_ALIGNMENT] = { 0 };
+    for (int i = 0; i < 5; i++) {
+        if (i == 0 && coordinates == NULL) continue;
+        out.write(padding, *offsets[i] - written);
+        out.write((const char*) sections[i], sizes[i]);
+        written = *offsets[i] + sizes[i];
+    }
+
+    out.close();
+    return !out.fail();
+}
+
+/// \brief
+///
+/// Checks that a section of the file lies inside it
+/// \param unsigned long long offset - byte offset of the section
+/// \param unsigned long long size - byte size of the section
+/// \return bool - true if inside the file and aligned
+bool GraphFile::isInside(unsigned long long offset, unsigned long long size){
+    return offset >= sizeof(GraphFileHeader) && offset % sizeof(double) == 0
+           && offset <= length && size <= length - offset;
+}
+
+/// \brief
+///
+/// Checks the adjacency and edge arrays in one pass, the row offsets
+/// never decreasing and every neighbour and edge end point a vertex
+/// \pre - every section is inside the file
+/// \return bool - true if every identifier names a vertex
+bool GraphFile::hasValidIds(){
+
+    unsigned int N = getNumVertices();
+    unsigned int M = getNumEdges();
+    const unsigned int* offsets = getOffsets();
+    const unsigned int* targets = getTargets();
+    const WeightedEdge* edges = getEdges();
+
+    for (unsigned int v = 0; v < N; v++) {
+        if (offsets[v] > offsets[v + 1]) return false;
+    }
+    for (unsigned int i = 0; i < 2 * M; i++) {
+        if (targets[i] >= N) return false;
+    }
+    for (unsigned int e = 0; e < M; e++) {
+        if (edges[e].source >= N || edges[e].destination >= N) return false;
+    }
+    return true;
+}
+
+/// \brief
+///
+/// Simple getter for the header at the start of the file
+/// \return const GraphFileHeader* - header
+const GraphFileHeader* GraphFile::getHeader(){
+    return (const GraphFileHeader*) data;
+}
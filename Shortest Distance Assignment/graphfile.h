@@ -0,0 +1,162 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: graphfile.h
+/// Header of GraphFile class
+/// Encapsulates a binary graph file mapped into memory,
+/// whose arrays are used in place as a graph's storage
+
+#ifndef _graphfile_h
+#define _graphfile_h
+
+#include <vector>
+
+#include "edge.h"
+
+// Constant identifying the format version written, a file
+// of any other version is not opened
+const unsigned int GRAPH_FILE_VERSION = 1;
+
+// Layout of the start of a graph file. Each section is found at its
+// byte offset from the start of the file, aligned to 64 bytes, and
+// a section offset of 0 marks a section the file does not have
+struct GraphFileHeader {
+    char magic[8];
+    unsigned int version;
+    unsigned int numVertices;
+    unsigned long long numEdges;
+    unsigned long long coordinatesOffset;
+    unsigned long long offsetsOffset;
+    unsigned long long targetsOffset;
+    unsigned long long weightsOffset;
+    unsigned long long edgesOffset;
+    unsigned long long fileSize;
+};
+
+/// Encapsulates a binary graph file mapped read only into memory. After the
+/// header the file holds the x and y coordinates of every vertex in pairs,
+/// the adjacency in compressed sparse row form and the list of edges in the
+/// order they were added, each array laid out exactly as a graph holds it in
+/// memory. Opening a file maps it and checks the header, the section bounds
+/// and, in one pass over the arrays, that every identifier in them names a
+/// vertex, so a damaged file is rejected rather than read out of bounds
+class GraphFile {
+
+    public:
+
+        /// \brief
+        ///
+        /// Constructor, initializes a graph file that is not open
+        GraphFile();
+
+        /// \brief
+        ///
+        /// Destructor, unmaps the file if open
+        ~GraphFile();
+
+        /// \brief
+        ///
+        /// Maps a graph file into memory, closing any file open before
+        /// \param const char* fileName - name of the file
+        /// \return bool - true if the file was mapped and is a graph file
+        /// of this version with every section inside the file and every
+        /// identifier in its arrays naming a vertex
+        bool open(const char* fileName);
+
+        /// \brief
+        ///
+        /// Unmaps the file, the arrays must no longer be in use
+        void close();
+
+        /// \brief
+        ///
+        /// Simple getter for whether a file is open
+        /// \return bool - true if open
+        bool isOpen();
+
+        /// \brief
+        ///
+        /// Simple getter for the number of vertices
+        /// \return unsigned int - number of vertices
+        unsigned int getNumVertices();
+
+        /// \brief
+        ///
+        /// Simple getter for the number of undirected edges
+        /// \return unsigned int - number of edges
+        unsigned int getNumEdges();
+
+        /// \brief
+        ///
+        /// Simple getter for the coordinates of every vertex in pairs
+        /// \return const double* - first x coordinate, NULL if the file has none
+        const double* getCoordinates();
+
+        /// \brief
+        ///
+        /// Simple getter for the row offsets of the adjacency, numVertices + 1 of them
+        /// \return const unsigned int* - pointer to the first offset
+        const unsigned int* getOffsets();
+
+        /// \brief
+        ///
+        /// Simple getter for the neighbour identifiers of the adjacency,
+        /// one for both ends of every edge
+        /// \return const unsigned int* - pointer to the first neighbour
+        const unsigned int* getTargets();
+
+        /// \brief
+        ///
+        /// Simple getter for the weights of the adjacency, parallel to the
+        /// neighbour identifiers
+        /// \return const double* - pointer to the first weight
+        const double* getWeights();
+
+        /// \brief
+        ///
+        /// Simple getter for the list of edges in the order they were added
+        /// \return const WeightedEdge* - first edge
+        const WeightedEdge* getEdges();
+
+        /// \brief
+        ///
+        /// Writes a graph file, building the adjacency arrays from the edges
+        /// \param const char* fileName - name of the file
+        /// \param unsigned int numVertices - number of vertices
+        /// \param const double* coordinates - x and y coordinates of every
+        /// vertex in pairs, or NULL if there are none
+        /// \param const vector<WeightedEdge>& edges - edges in the order added
+        /// \return bool - true if the whole file was written
+        static bool write(const char* fileName, unsigned int numVertices, const double* coordinates,
+                          const std::vector<WeightedEdge>& edges);
+
+    private:
+
+        // Instance variables storing the mapped file and its length
+        const char* data;
+        unsigned long long length;
+
+        /// \brief
+        ///
+        /// Checks that a section of the file lies inside it
+        /// \param unsigned long long offset - byte offset of the section
+        /// \param unsigned long long size - byte size of the section
+        /// \return bool - true if inside the file and aligned
+        bool isInside(unsigned long long offset, unsigned long long size);
+
+        /// \brief
+        ///
+        /// Checks the adjacency and edge arrays in one pass, the row offsets
+        /// never decreasing and every neighbour and edge end point a vertex
+        /// \pre - every section is inside the file
+        /// \return bool - true if every identifier names a vertex
+        bool hasValidIds();
+
+        /// \brief
+        ///
+        /// Simple getter for the header at the start of the file
+        /// \return const GraphFileHeader* - header
+        const GraphFileHeader* getHeader();
+
+};
+
+#endif // _graphfile_h
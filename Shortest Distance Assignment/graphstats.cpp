@@ -0,0 +1,142 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: graphstats.cpp
+/// Implementation of StatsRecorder class
+/// Encapsulates counters of the work done by the searches,
+/// disjoint sets and minimum spanning trees of each thread
+
+#include "graphstats.h"
+
+thread_local StatsRecorder StatsRecorder::recorder;
+
+/// Encapsulates the counters of one thread. Each thread counts into its own
+/// recorder, created the first time it counts anything, so counting needs no
+/// lock and no two threads write the same cache line. Every recorder is
+/// listed in a registry, and the counts of recorders whose threads have
+/// ended are kept, so the totals can be gathered at any time.
+/// Counting is compiled in only when GRAPH_STATS is defined, otherwise
+/// GRAPH_STATS_COUNT expands to nothing and no recorder is ever created
+
+/// \brief
+///
+/// Constructor, initializes a thread's counters and lists them
+StatsRecorder::StatsRecorder(){
+    for (int c = 0; c < NUM_COUNTERS; c++) {
+        counts[c].store(0, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> lock(getMutex());
+    getRecorders().push_back(this);
+}
+
+/// \brief
+///
+/// Destructor, keeps the counts of a thread that has ended
+StatsRecorder::~StatsRecorder(){
+    std::lock_guard<std::mutex> lock(getMutex());
+    std::vector<StatsRecorder*>& recorders = getRecorders();
+    for (size_t r = 0; r < recorders.size(); r++) {
+        if (recorders[r] == this) {
+            recorders[r] = recorders.back();
+            recorders.pop_back();
+            break;
+        }
+    }
+    unsigned long long* retired = getRetired();
+    for (int c = 0; c < NUM_COUNTERS; c++) {
+        retired[c] += counts[c].load(std::memory_order_relaxed);
+    }
+}
+
+/// \brief
+///
+/// Gathers the counts of every thread since the last reset
+/// \return GraphStats - totals of the counters
+GraphStats StatsRecorder::total(){
+
+    unsigned long long sums[NUM_COUNTERS];
+    {
+        std::lock_guard<std::mutex> lock(getMutex());
+        sum(sums);
+        unsigned long long* resetCounts = getResetCounts();
+        for (int c = 0; c < NUM_COUNTERS; c++) {
+            sums[c] -= resetCounts[c];
+        }
+    }
+
+    GraphStats stats;
+    stats.relaxations = sums[RELAXATIONS];
+    stats.heapPushes = sums[HEAP_PUSHES];
+    stats.heapDecreases = sums[HEAP_DECREASES];
+    stats.heapPops = sums[HEAP_POPS];
+    stats.verticesSettled = sums[VERTICES_SETTLED];
+    stats.finds = sums[FINDS];
+    stats.findPathLength = sums[FIND_PATH_LENGTH];
+    stats.compressionWrites = sums[COMPRESSION_WRITES];
+    stats.edgesScanned = sums[EDGES_SCANNED];
+    stats.edgesRejected = sums[EDGES_REJECTED];
+    return stats;
+}
+
+/// \brief
+///
+/// Starts the totals again from zero. The counts themselves are left
+/// alone, as other threads may be adding to them, and those at the
+/// reset are subtracted from later totals instead
+void StatsRecorder::reset(){
+    std::lock_guard<std::mutex> lock(getMutex());
+    sum(getResetCounts());
+}
+
+/// \brief
+///
+/// Checks whether counting is compiled in
+/// \return bool - true if GRAPH_STATS was defined
+bool StatsRecorder::isEnabled(){
+#ifdef GRAPH_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// \brief
+///
+/// Gathers the counts of every thread since the program started
+/// \pre - the registry lock is held
+/// \param unsigned long long* sums - filled with the count of each counter
+void StatsRecorder::sum(unsigned long long* sums){
+    unsigned long long* retired = getRetired();
+    std::vector<StatsRecorder*>& recorders = getRecorders();
+    for (int c = 0; c < NUM_COUNTERS; c++) {
+        sums[c] = retired[c];
+        for (size_t r = 0; r < recorders.size(); r++) {
+            sums[c] += recorders[r]->counts[c].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/// \brief
+///
+/// Simple getters for the lock guarding the registry, the recorders of
+/// running threads, the counts of ended threads and the counts at the
+/// last reset. Each is created on first use, so recorders of threads
+/// ending while the program exits still find them
+std::mutex& StatsRecorder::getMutex(){
+    static std::mutex* mutex = new std::mutex();
+    return *mutex;
+}
+
+std::vector<StatsRecorder*>& StatsRecorder::getRecorders(){
+    static std::vector<StatsRecorder*>* recorders = new std::vector<StatsRecorder*>();
+    return *recorders;
+}
+
+unsigned long long* StatsRecorder::getRetired(){
+    static unsigned long long retired[NUM_COUNTERS] = {};
+    return retired;
+}
+
+unsigned long long* StatsRecorder::getResetCounts(){
+    static unsigned long long resetCounts[NUM_COUNTERS] = {};
+    return resetCounts;
+}
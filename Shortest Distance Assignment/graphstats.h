@@ -0,0 +1,121 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: graphstats.h
+/// Header of StatsRecorder class and GraphStats totals
+/// Encapsulates counters of the work done by the searches,
+/// disjoint sets and minimum spanning trees of each thread
+
+#ifndef _graphstats_h
+#define _graphstats_h
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// Totals of the counters across every thread since they were last reset,
+// all zero unless the program is compiled with GRAPH_STATS defined
+struct GraphStats {
+    unsigned long long relaxations;       // edges looked along from vertices settled by Dijkstra's algorithm or bfs
+    unsigned long long heapPushes;        // vertices pushed onto an indexed heap
+    unsigned long long heapDecreases;     // keys lowered in place in an indexed heap
+    unsigned long long heapPops;          // vertices popped from an indexed heap
+    unsigned long long verticesSettled;   // vertices settled by Dijkstra's algorithm or dequeued by bfs
+    unsigned long long finds;             // calls to DisjointSet::find
+    unsigned long long findPathLength;    // parent links followed by those finds
+    unsigned long long compressionWrites; // parent links shortened by those finds
+    unsigned long long edgesScanned;      // edges considered for a minimum spanning tree
+    unsigned long long edgesRejected;     // of those, edges inside a component already
+};
+
+/// Encapsulates the counters of one thread. Each thread counts into its own
+/// recorder, created the first time it counts anything, so counting needs no
+/// lock and no two threads write the same cache line. Every recorder is
+/// listed in a registry, and the counts of recorders whose threads have
+/// ended are kept, so the totals can be gathered at any time.
+/// Counting is compiled in only when GRAPH_STATS is defined, otherwise
+/// GRAPH_STATS_COUNT expands to nothing and no recorder is ever created
+class StatsRecorder {
+
+    public:
+
+        // Counters, in the order of the totals in GraphStats
+        enum Counter { RELAXATIONS, HEAP_PUSHES, HEAP_DECREASES, HEAP_POPS, VERTICES_SETTLED, FINDS,
+                       FIND_PATH_LENGTH, COMPRESSION_WRITES, EDGES_SCANNED, EDGES_REJECTED, NUM_COUNTERS };
+
+        /// \brief
+        ///
+        /// Constructor, initializes a thread's counters and lists them
+        StatsRecorder();
+
+        /// \brief
+        ///
+        /// Destructor, keeps the counts of a thread that has ended
+        ~StatsRecorder();
+
+        /// \brief
+        ///
+        /// Adds to one of the calling thread's counters. Defined in this header
+        /// so the addition is inlined into the loops that count
+        /// \param Counter counter - counter to add to
+        /// \param unsigned long long n - amount to add
+        static void count(Counter counter, unsigned long long n);
+
+        /// \brief
+        ///
+        /// Gathers the counts of every thread since the last reset
+        /// \return GraphStats - totals of the counters
+        static GraphStats total();
+
+        /// \brief
+        ///
+        /// Starts the totals again from zero
+        static void reset();
+
+        /// \brief
+        ///
+        /// Checks whether counting is compiled in
+        /// \return bool - true if GRAPH_STATS was defined
+        static bool isEnabled();
+
+    private:
+
+        // Instance variable storing the thread's counts, written only by the
+        // thread itself but atomic so other threads can read them at any time
+        std::atomic<unsigned long long> counts[NUM_COUNTERS];
+
+        // Recorder of the calling thread
+        static thread_local StatsRecorder recorder;
+
+        /// \brief
+        ///
+        /// Gathers the counts of every thread since the program started
+        /// \pre - the registry lock is held
+        /// \param unsigned long long* sums - filled with the count of each counter
+        static void sum(unsigned long long* sums);
+
+        /// \brief
+        ///
+        /// Simple getters for the lock guarding the registry, the recorders of
+        /// running threads, the counts of ended threads and the counts at the
+        /// last reset
+        static std::mutex& getMutex();
+        static std::vector<StatsRecorder*>& getRecorders();
+        static unsigned long long* getRetired();
+        static unsigned long long* getResetCounts();
+
+};
+
+inline void StatsRecorder::count(Counter counter, unsigned long long n){
+    // Only this thread writes its counts, so a load and a store
+    // suffice where an atomic addition would lock the bus
+    std::atomic<unsigned long long>& c = recorder.counts[counter];
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+#ifdef GRAPH_STATS
+#define GRAPH_STATS_COUNT(counter, n) StatsRecorder::count(StatsRecorder::counter, (n))
+#else
+#define GRAPH_STATS_COUNT(counter, n) ((void) 0)
+#endif
+
+#endif // _graphstats_h
@@ -0,0 +1,225 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: indexedheap.cpp
+/// Implementation of IndexedHeap class
+/// Encapsulates an indexed 4-ary min heap of vertex identifiers
+/// keyed by distance, with a decrease-key operation so each
+/// vertex is held in the heap at most once
+
+#include "indexedheap.h"
+#include "graphstats.h"
+
+// Constant defining the number of children of each heap node,
+// 4 keeps the tree shallow while a node's children share a cache line
+const unsigned int ARITY = 4;
+
+/// Encapsulates an indexed 4-ary min heap over the identifiers [0, capacity).
+/// Entries are stored contiguously as (key, identifier) pairs alongside a
+/// position array mapping each identifier to its slot, which allows keys to
+/// be decreased in place rather than pushing duplicate entries
+
+/// \brief
+///
+/// No argument constructor, initializes an empty heap
+/// that cannot hold any identifiers until resized
+IndexedHeap::IndexedHeap(){
+}
+
+/// \brief
+///
+/// Constructor, initializes an empty heap for a range of identifiers
+/// \param unsigned int - number of identifiers the heap can hold
+IndexedHeap::IndexedHeap(unsigned int capacity){
+    positions.assign(capacity, NOT_IN_HEAP);
+}
+
+/// \brief
+///
+/// Destructor, no objects dynamically created from this class
+IndexedHeap::~IndexedHeap(){
+}
+
+/// \brief
+///
+/// Empties the heap and changes the range of identifiers it can hold
+/// \param unsigned int - number of identifiers the heap can hold
+void IndexedHeap::resize(unsigned int capacity){
+    entries.clear();
+    positions.assign(capacity, NOT_IN_HEAP);
+}
+
+/// \brief
+///
+/// Simple getter for whether the heap holds no entries
+/// \return bool - true if empty
+bool IndexedHeap::isEmpty(){
+    return entries.empty();
+}
+
+/// \brief
+///
+/// Simple getter for the number of entries in the heap
+/// \return unsigned int - number of entries
+unsigned int IndexedHeap::getSize(){
+    return entries.size();
+}
+
+/// \brief
+///
+/// Checks whether an identifier currently sits in the heap
+/// \param unsigned int id - identifier
+/// \return bool - true if present
+bool IndexedHeap::contains(unsigned int id){
+    return positions[id] != NOT_IN_HEAP;
+}
+
+/// \brief
+///
+/// Inserts an identifier with the specified key
+/// \pre - the identifier is not already in the heap
+/// \param unsigned int id - identifier
+/// \param double key - key of the identifier
+void IndexedHeap::push(unsigned int id, double key){
+    GRAPH_STATS_COUNT(HEAP_PUSHES, 1);
+    Entry e;
+    e.key = key;
+    e.id = id;
+    entries.push_back(e);
+    positions[id] = entries.size() - 1;
+    siftUp(entries.size() - 1);
+}
+
+/// \brief
+///
+/// Lowers the key of an identifier already in the heap
+/// \pre - the new key is not greater than the current key
+/// \param unsigned int id - identifier
+/// \param double key - new key of the identifier
+void IndexedHeap::decreaseKey(unsigned int id, double key){
+    GRAPH_STATS_COUNT(HEAP_DECREASES, 1);
+    unsigned int slot = positions[id];
+    entries[slot].key = key;
+    siftUp(slot);
+}
+
+/// \brief
+///
+/// Inserts an identifier, or lowers its key if it is already present
+/// and the specified key is smaller
+/// \param unsigned int id - identifier
+/// \param double key - key of the identifier
+void IndexedHeap::pushOrDecrease(unsigned int id, double key){
+    unsigned int slot = positions[id];
+    if (slot == NOT_IN_HEAP) {
+        push(id, key);
+    } else if (key < entries[slot].key) {
+        GRAPH_STATS_COUNT(HEAP_DECREASES, 1);
+        entries[slot].key = key;
+        siftUp(slot);
+    }
+}
+
+/// \brief
+///
+/// Simple getter for the identifier with the smallest key
+/// \pre - the heap is not empty
+/// \return unsigned int - identifier with the smallest key
+unsigned int IndexedHeap::top(){
+    return entries[0].id;
+}
+
+/// \brief
+///
+/// Simple getter for the smallest key in the heap
+/// \pre - the heap is not empty
+/// \return double - smallest key
+double IndexedHeap::topKey(){
+    return entries[0].key;
+}
+
+/// \brief
+///
+/// Removes and returns the identifier with the smallest key
+/// \pre - the heap is not empty
+/// \return unsigned int - identifier with the smallest key
+unsigned int IndexedHeap::pop(){
+
+    GRAPH_STATS_COUNT(HEAP_POPS, 1);
+    unsigned int id = entries[0].id;
+    positions[id] = NOT_IN_HEAP;
+
+    // Move the last entry into the root and restore the heap order
+    Entry last = entries.back();
+    entries.pop_back();
+    if (!entries.empty()) {
+        entries[0] = last;
+        positions[last.id] = 0;
+        siftDown(0);
+    }
+
+    return id;
+}
+
+/// \brief
+///
+/// Removes all entries, in time proportional to the number of entries
+void IndexedHeap::clear(){
+    for (unsigned i = 0; i < entries.size(); i++) {
+        positions[entries[i].id] = NOT_IN_HEAP;
+    }
+    entries.clear();
+}
+
+/// \brief
+///
+/// Moves the entry at a slot towards the root until
+/// its parent's key is not greater
+/// \param unsigned int - slot of the entry
+void IndexedHeap::siftUp(unsigned int slot){
+
+    // Shift parents down into the hole instead of swapping,
+    // then drop the moving entry into its final slot
+    Entry moving = entries[slot];
+    while (slot > 0) {
+        unsigned int parent = (slot - 1) / ARITY;
+        if (entries[parent].key <= moving.key) break;
+        entries[slot] = entries[parent];
+        positions[entries[slot].id] = slot;
+        slot = parent;
+    }
+    entries[slot] = moving;
+    positions[moving.id] = slot;
+}
+
+/// \brief
+///
+/// Moves the entry at a slot towards the leaves until
+/// none of its children's keys are smaller
+/// \param unsigned int - slot of the entry
+void IndexedHeap::siftDown(unsigned int slot){
+
+    Entry moving = entries[slot];
+    unsigned int size = entries.size();
+
+    while (true) {
+
+        // Find the child with the smallest key
+        unsigned int first = slot * ARITY + 1;
+        if (first >= size) break;
+
+        unsigned int last = first + ARITY < size ? first + ARITY : size;
+        unsigned int smallest = first;
+        for (unsigned int child = first + 1; child < last; child++) {
+            if (entries[child].key < entries[smallest].key) {
+                smallest = child;
+            }
+        }
+
+        if (moving.key <= entries[smallest].key) break;
+        entries[slot] = entries[smallest];
+        positions[entries[slot].id] = slot;
+        slot = smallest;
+    }
+    entries[slot] = moving;
+    positions[moving.id] = slot;
+}
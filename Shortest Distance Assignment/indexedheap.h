@@ -0,0 +1,146 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: indexedheap.h
+/// Header of IndexedHeap class
+/// Encapsulates an indexed 4-ary min heap of vertex identifiers
+/// keyed by distance, with a decrease-key operation so each
+/// vertex is held in the heap at most once
+
+#ifndef _indexedheap_h
+#define _indexedheap_h
+
+#include <vector>
+
+// Constant marking an identifier that is not currently in the heap
+const unsigned int NOT_IN_HEAP = 0xFFFFFFFF;
+
+/// Encapsulates an indexed 4-ary min heap over the identifiers [0, capacity).
+/// Entries are stored contiguously as (key, identifier) pairs alongside a
+/// position array mapping each identifier to its slot, which allows keys to
+/// be decreased in place rather than pushing duplicate entries
+class IndexedHeap {
+
+    public:
+
+        /// \brief
+        ///
+        /// No argument constructor, initializes an empty heap
+        /// that cannot hold any identifiers until resized
+        IndexedHeap();
+
+        /// \brief
+        ///
+        /// Constructor, initializes an empty heap for a range of identifiers
+        /// \param unsigned int - number of identifiers the heap can hold
+        IndexedHeap(unsigned int);
+
+        /// \brief
+        ///
+        /// Destructor, no objects dynamically created from this class
+        ~IndexedHeap();
+
+        /// \brief
+        ///
+        /// Empties the heap and changes the range of identifiers it can hold
+        /// \param unsigned int - number of identifiers the heap can hold
+        void resize(unsigned int);
+
+        /// \brief
+        ///
+        /// Simple getter for whether the heap holds no entries
+        /// \return bool - true if empty
+        bool isEmpty();
+
+        /// \brief
+        ///
+        /// Simple getter for the number of entries in the heap
+        /// \return unsigned int - number of entries
+        unsigned int getSize();
+
+        /// \brief
+        ///
+        /// Checks whether an identifier currently sits in the heap
+        /// \param unsigned int id - identifier
+        /// \return bool - true if present
+        bool contains(unsigned int id);
+
+        /// \brief
+        ///
+        /// Inserts an identifier with the specified key
+        /// \pre - the identifier is not already in the heap
+        /// \param unsigned int id - identifier
+        /// \param double key - key of the identifier
+        void push(unsigned int id, double key);
+
+        /// \brief
+        ///
+        /// Lowers the key of an identifier already in the heap
+        /// \pre - the new key is not greater than the current key
+        /// \param unsigned int id - identifier
+        /// \param double key - new key of the identifier
+        void decreaseKey(unsigned int id, double key);
+
+        /// \brief
+        ///
+        /// Inserts an identifier, or lowers its key if it is already present
+        /// and the specified key is smaller
+        /// \param unsigned int id - identifier
+        /// \param double key - key of the identifier
+        void pushOrDecrease(unsigned int id, double key);
+
+        /// \brief
+        ///
+        /// Simple getter for the identifier with the smallest key
+        /// \pre - the heap is not empty
+        /// \return unsigned int - identifier with the smallest key
+        unsigned int top();
+
+        /// \brief
+        ///
+        /// Simple getter for the smallest key in the heap
+        /// \pre - the heap is not empty
+        /// \return double - smallest key
+        double topKey();
+
+        /// \brief
+        ///
+        /// Removes and returns the identifier with the smallest key
+        /// \pre - the heap is not empty
+        /// \return unsigned int - identifier with the smallest key
+        unsigned int pop();
+
+        /// \brief
+        ///
+        /// Removes all entries, in time proportional to the number of entries
+        void clear();
+
+    private:
+
+        // Entry of the heap array, a key and its identifier
+        struct Entry {
+            double key;
+            unsigned int id;
+        };
+
+        // Instance variables storing the heap array and the
+        // slot of every identifier within it
+        std::vector<Entry> entries;
+        std::vector<unsigned int> positions;
+
+        /// \brief
+        ///
+        /// Moves the entry at a slot towards the root until
+        /// its parent's key is not greater
+        /// \param unsigned int - slot of the entry
+        void siftUp(unsigned int);
+
+        /// \brief
+        ///
+        /// Moves the entry at a slot towards the leaves until
+        /// none of its children's keys are smaller
+        /// \param unsigned int - slot of the entry
+        void siftDown(unsigned int);
+
+};
+
+#endif // _indexedheap_h
@@ -0,0 +1,326 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: kdtree.cpp
+/// Implementation of KdTree class
+/// Encapsulates a 2-d tree over a set of points, used to join each
+/// point to its nearest neighbours in O(N log N) time
+
+#include <algorithm>
+
+#include "kdtree.h"
+#include "threadpool.h"
+
+// Constant defining the greatest number of points in a subtree
+// that is scanned rather than split any further
+const unsigned int LEAF_SIZE = 8;
+
+/// Encapsulates a balanced 2-d tree over a set of points. The tree is
+/// implicit: the points are reordered so each subtree is a contiguous
+/// range whose middle point splits the rest by x at even depths and by y
+/// at odd depths, and ranges of a few points are left unsplit and scanned.
+/// The tree finds the k nearest points to any point, or every point within
+/// a radius of it, and joins every point to those found to make a road
+/// network like graph with O(N) edges, the searches shared among threads.
+/// Distances are calculated as Point::distanceTo calculates them, and
+/// points closer to a point are always found before points further away,
+/// the one with the lower ID first among points at the same distance
+
+/// \brief
+///
+/// Constructor, initializes an empty tree
+KdTree::KdTree(){
+    points = NULL;
+}
+
+/// \brief
+///
+/// Destructor, no objects dynamically created from this class
+KdTree::~KdTree(){
+}
+
+/// \brief
+///
+/// Builds the tree over a set of points, replacing any built before.
+/// The points must not change while the tree is in use
+/// \param PointSet* points - points, whose indices are their IDs
+void KdTree::build(PointSet* points){
+
+    this->points = points;
+    unsigned int numPoints = points->getSize();
+    order.resize(numPoints);
+    for (unsigned int i = 0; i < numPoints; i++) {
+        order[i] = i;
+    }
+    arrange(0, numPoints, 0);
+
+    // Copy the coordinates into tree order, so the points of a
+    // subtree are next to each other in memory as they are searched
+    const double* x = points->getXs();
+    const double* y = points->getYs();
+    xs.resize(numPoints);
+    ys.resize(numPoints);
+    for (unsigned int i = 0; i < numPoints; i++) {
+        xs[i] = x[order[i]];
+        ys[i] = y[order[i]];
+    }
+}
+
+/// \brief
+///
+/// Finds the points nearest to a point, other than itself
+/// \param unsigned int id - point to search from
+/// \param unsigned int k - number of points to find
+/// \param vector<unsigned int>& found - filled with the IDs of the
+/// nearest points, nearest first, fewer than k if there are fewer
+void KdTree::nearest(unsigned int id, unsigned int k, std::vector<unsigned int>& found){
+
+    std::vector<Candidate> heap;
+    found.clear();
+    if (k == 0) return;
+
+    heap.reserve(k);
+    searchNearest(id, points->getXs()[id], points->getYs()[id], k, 0, order.size(), 0, heap);
+    std::sort_heap(heap.begin(), heap.end());
+    for (unsigned int i = 0; i < heap.size(); i++) {
+        found.push_back(heap[i].id);
+    }
+}
+
+/// \brief
+///
+/// Finds every point within a distance of a point, other than itself
+/// \param unsigned int id - point to search from
+/// \param double radius - greatest distance of a point found
+/// \param vector<unsigned int>& found - filled with the IDs of the
+/// points found in increasing order
+void KdTree::within(unsigned int id, double radius, std::vector<unsigned int>& found){
+    found.clear();
+    searchWithin(id, points->getXs()[id], points->getYs()[id], radius, 0, order.size(), 0, found);
+    std::sort(found.begin(), found.end());
+}
+
+/// \brief
+///
+/// Joins every point to its k nearest points, appending each edge
+/// once, weighted by its length. A point may have more than k edges,
+/// as it is also joined to every point it is among the nearest of
+/// \param unsigned int k - number of nearest points joined
+/// \param unsigned int numThreads - number of threads, 0 for one
+/// per hardware thread
+/// \param vector<WeightedEdge>& edges - collection the edges are
+/// appended to, ordered by source then destination, source first
+void KdTree::nearestNeighbourEdges(unsigned int k, unsigned int numThreads, std::vector<WeightedEdge>& edges){
+
+    ThreadPool pool(numThreads);
+    std::vector<std::vector<unsigned long long> > pairs(pool.getNumWorkers());
+    std::vector<std::vector<unsigned int> > found(pool.getNumWorkers());
+
+    // Points are searched from in tree order, so consecutive searches
+    // visit mostly the same subtrees while they are still in cache
+    pool.parallelFor(order.size(), [&](unsigned int position, unsigned int worker) {
+        unsigned int i = order[position];
+        nearest(i, k, found[worker]);
+        for (unsigned int j : found[worker]) {
+            unsigned long long low = i < j ? i : j;
+            unsigned long long high = i < j ? j : i;
+            pairs[worker].push_back(low << 32 | high);
+        }
+    });
+    appendEdges(pairs, edges);
+}
+
+/// \brief
+///
+/// Joins every pair of points within a distance of each other,
+/// appending each edge once, weighted by its length
+/// \param double radius - greatest length of an edge
+/// \param unsigned int numThreads - number of threads, 0 for one
+/// per hardware thread
+/// \param vector<WeightedEdge>& edges - collection the edges are
+/// appended to, ordered by source then destination, source first
+void KdTree::radiusEdges(double radius, unsigned int numThreads, std::vector<WeightedEdge>& edges){
+
+    ThreadPool pool(numThreads);
+    std::vector<std::vector<unsigned long long> > pairs(pool.getNumWorkers());
+    std::vector<std::vector<unsigned int> > found(pool.getNumWorkers());
+
+    // Each pair is found from both of its points, only the lower keeps it
+    pool.parallelFor(order.size(), [&](unsigned int position, unsigned int worker) {
+        unsigned int i = order[position];
+        within(i, radius, found[worker]);
+        for (unsigned int j : found[worker]) {
+            if (i < j) {
+                pairs[worker].push_back((unsigned long long) i << 32 | j);
+            }
+        }
+    });
+    appendEdges(pairs, edges);
+}
+
+/// \brief
+///
+/// Orders two points found by a search, nearest first
+/// \param const Candidate& other - the other point
+/// \return bool - true if this point is nearer, or as near with a lower ID
+bool KdTree::Candidate::operator<(const Candidate& other) const{
+    return squared < other.squared || (squared == other.squared && id < other.id);
+}
+
+/// \brief
+///
+/// Arranges the points of a subtree, putting the median by the
+/// subtree's coordinate in the middle and arranging either side
+/// \param unsigned int low - first position of the subtree
+/// \param unsigned int high - one past the last position
+/// \param unsigned int depth - depth of the subtree's root
+void KdTree::arrange(unsigned int low, unsigned int high, unsigned int depth){
+
+    if (high - low <= LEAF_SIZE) return;
+
+    unsigned int mid = low + (high - low) / 2;
+    const double* coordinate = depth % 2 == 0 ? points->getXs() : points->getYs();
+    std::nth_element(order.begin() + low, order.begin() + mid, order.begin() + high,
+                     [coordinate](unsigned int a, unsigned int b) {
+                         return coordinate[a] < coordinate[b];
+                     });
+    arrange(low, mid, depth + 1);
+    arrange(mid + 1, high, depth + 1);
+}
+
+/// \brief
+///
+/// Searches a subtree for points nearer than the furthest found so far
+/// \param unsigned int id - point searched from
+/// \param double x - point searched from on x-axis
+/// \param double y - point searched from on y-axis
+/// \param unsigned int k - number of points to find
+/// \param unsigned int low - first position of the subtree
+/// \param unsigned int high - one past the last position
+/// \param unsigned int depth - depth of the subtree's root
+/// \param vector<Candidate>& heap - the nearest points found so far,
+/// a max-heap of at most k with the furthest at the front
+void KdTree::searchNearest(unsigned int id, double x, double y, unsigned int k, unsigned int low,
+                           unsigned int high, unsigned int depth, std::vector<Candidate>& heap){
+
+    if (high - low <= LEAF_SIZE) {
+        for (unsigned int p = low; p < high; p++) {
+            if (order[p] != id) {
+                offer(k, p, x, y, heap);
+            }
+        }
+        return;
+    }
+
+    // Search the side of the splitting line holding the point first, then
+    // the other side only if the line is no further than the furthest found
+    unsigned int mid = low + (high - low) / 2;
+    double offset = depth % 2 == 0 ? x - xs[mid] : y - ys[mid];
+    if (offset < 0) {
+        searchNearest(id, x, y, k, low, mid, depth + 1, heap);
+    } else {
+        searchNearest(id, x, y, k, mid + 1, high, depth + 1, heap);
+    }
+    if (order[mid] != id) {
+        offer(k, mid, x, y, heap);
+    }
+    if (heap.size() < k || offset * offset <= heap.front().squared) {
+        if (offset < 0) {
+            searchNearest(id, x, y, k, mid + 1, high, depth + 1, heap);
+        } else {
+            searchNearest(id, x, y, k, low, mid, depth + 1, heap);
+        }
+    }
+}
+
+/// \brief
+///
+/// Searches a subtree for points within a squared distance
+/// \param unsigned int id - point searched from
+/// \param double x - point searched from on x-axis
+/// \param double y - point searched from on y-axis
+/// \param double radius - greatest distance of a point found
+/// \param unsigned int low - first position of the subtree
+/// \param unsigned int high - one past the last position
+/// \param unsigned int depth - depth of the subtree's root
+/// \param vector<unsigned int>& found - the IDs of the points found
+void KdTree::searchWithin(unsigned int id, double x, double y, double radius, unsigned int low,
+                          unsigned int high, unsigned int depth, std::vector<unsigned int>& found){
+
+    if (high - low <= LEAF_SIZE) {
+        for (unsigned int p = low; p < high; p++) {
+            if (order[p] != id && PointSet::distance(x, y, xs[p], ys[p]) <= radius) {
+                found.push_back(order[p]);
+            }
+        }
+        return;
+    }
+
+    unsigned int mid = low + (high - low) / 2;
+    double offset = depth % 2 == 0 ? x - xs[mid] : y - ys[mid];
+    if (order[mid] != id && PointSet::distance(x, y, xs[mid], ys[mid]) <= radius) {
+        found.push_back(order[mid]);
+    }
+    if (offset <= radius) {
+        searchWithin(id, x, y, radius, low, mid, depth + 1, found);
+    }
+    if (-offset <= radius) {
+        searchWithin(id, x, y, radius, mid + 1, high, depth + 1, found);
+    }
+}
+
+/// \brief
+///
+/// Offers a point to the nearest points found so far, keeping it
+/// if fewer than k have been found or it is nearer than the furthest
+/// \param unsigned int k - number of points to find
+/// \param unsigned int position - position of the point in tree order
+/// \param double x - point searched from on x-axis
+/// \param double y - point searched from on y-axis
+/// \param vector<Candidate>& heap - the nearest points found so far
+void KdTree::offer(unsigned int k, unsigned int position, double x, double y, std::vector<Candidate>& heap){
+
+    double dx = x - xs[position];
+    double dy = y - ys[position];
+    Candidate candidate;
+    candidate.squared = dx * dx + dy * dy;
+    candidate.id = order[position];
+
+    if (heap.size() < k) {
+        heap.push_back(candidate);
+        std::push_heap(heap.begin(), heap.end());
+    } else if (candidate < heap.front()) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = candidate;
+        std::push_heap(heap.begin(), heap.end());
+    }
+}
+
+/// \brief
+///
+/// Appends an edge for every pair found, once each however many
+/// times it was found, sorted by source then destination
+/// \param vector<vector<unsigned long long> >& pairs - pairs found by each
+/// thread, the lower ID of each in the high half and the higher in the low
+/// \param vector<WeightedEdge>& edges - collection the edges are appended to
+void KdTree::appendEdges(std::vector<std::vector<unsigned long long> >& pairs, std::vector<WeightedEdge>& edges){
+
+    std::vector<unsigned long long> all;
+    for (unsigned int w = 0; w < pairs.size(); w++) {
+        all.insert(all.end(), pairs[w].begin(), pairs[w].end());
+        std::vector<unsigned long long>().swap(pairs[w]);
+    }
+    std::sort(all.begin(), all.end());
+    all.erase(std::unique(all.begin(), all.end()), all.end());
+
+    unsigned int first = edges.size();
+    edges.reserve(first + all.size());
+    for (unsigned long long pair : all) {
+        WeightedEdge edge;
+        edge.source = pair >> 32;
+        edge.destination = pair & 0xffffffffULL;
+        edges.push_back(edge);
+    }
+
+    // The edges from each point are together, so they are weighed together
+    points->weighEdges(edges.data() + first, all.size());
+}
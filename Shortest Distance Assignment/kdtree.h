@@ -0,0 +1,165 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: kdtree.h
+/// Header of KdTree class
+/// Encapsulates a 2-d tree over a set of points, used to join each
+/// point to its nearest neighbours in O(N log N) time
+
+#ifndef _kdtree_h
+#define _kdtree_h
+
+#include <vector>
+
+#include "edge.h"
+#include "pointset.h"
+
+/// Encapsulates a balanced 2-d tree over a set of points. The tree is
+/// implicit: the points are reordered so each subtree is a contiguous
+/// range whose middle point splits the rest by x at even depths and by y
+/// at odd depths, and ranges of a few points are left unsplit and scanned.
+/// The tree finds the k nearest points to any point, or every point within
+/// a radius of it, and joins every point to those found to make a road
+/// network like graph with O(N) edges, the searches shared among threads.
+/// Distances are calculated as Point::distanceTo calculates them, and
+/// points closer to a point are always found before points further away,
+/// the one with the lower ID first among points at the same distance
+class KdTree {
+
+    public:
+
+        /// \brief
+        ///
+        /// Constructor, initializes an empty tree
+        KdTree();
+
+        /// \brief
+        ///
+        /// Destructor, no objects dynamically created from this class
+        ~KdTree();
+
+        /// \brief
+        ///
+        /// Builds the tree over a set of points, replacing any built before.
+        /// The points must not change while the tree is in use
+        /// \param PointSet* points - points, whose indices are their IDs
+        void build(PointSet* points);
+
+        /// \brief
+        ///
+        /// Finds the points nearest to a point, other than itself
+        /// \param unsigned int id - point to search from
+        /// \param unsigned int k - number of points to find
+        /// \param vector<unsigned int>& found - filled with the IDs of the
+        /// nearest points, nearest first, fewer than k if there are fewer
+        void nearest(unsigned int id, unsigned int k, std::vector<unsigned int>& found);
+
+        /// \brief
+        ///
+        /// Finds every point within a distance of a point, other than itself
+        /// \param unsigned int id - point to search from
+        /// \param double radius - greatest distance of a point found
+        /// \param vector<unsigned int>& found - filled with the IDs of the
+        /// points found in increasing order
+        void within(unsigned int id, double radius, std::vector<unsigned int>& found);
+
+        /// \brief
+        ///
+        /// Joins every point to its k nearest points, appending each edge
+        /// once, weighted by its length. A point may have more than k edges,
+        /// as it is also joined to every point it is among the nearest of
+        /// \param unsigned int k - number of nearest points joined
+        /// \param unsigned int numThreads - number of threads, 0 for one
+        /// per hardware thread
+        /// \param vector<WeightedEdge>& edges - collection the edges are
+        /// appended to, ordered by source then destination, source first
+        void nearestNeighbourEdges(unsigned int k, unsigned int numThreads, std::vector<WeightedEdge>& edges);
+
+        /// \brief
+        ///
+        /// Joins every pair of points within a distance of each other,
+        /// appending each edge once, weighted by its length
+        /// \param double radius - greatest length of an edge
+        /// \param unsigned int numThreads - number of threads, 0 for one
+        /// per hardware thread
+        /// \param vector<WeightedEdge>& edges - collection the edges are
+        /// appended to, ordered by source then destination, source first
+        void radiusEdges(double radius, unsigned int numThreads, std::vector<WeightedEdge>& edges);
+
+    private:
+
+        // A point found by a search, ordered by its squared distance
+        // and then its ID so ties are broken the same way every time
+        struct Candidate {
+            double squared;
+            unsigned int id;
+            bool operator<(const Candidate& other) const;
+        };
+
+        // Instance variables storing the points, the IDs of the points in
+        // tree order and their x and y coordinates in the same order
+        PointSet* points;
+        std::vector<unsigned int> order;
+        std::vector<double> xs;
+        std::vector<double> ys;
+
+        /// \brief
+        ///
+        /// Arranges the points of a subtree, putting the median by the
+        /// subtree's coordinate in the middle and arranging either side
+        /// \param unsigned int low - first position of the subtree
+        /// \param unsigned int high - one past the last position
+        /// \param unsigned int depth - depth of the subtree's root
+        void arrange(unsigned int low, unsigned int high, unsigned int depth);
+
+        /// \brief
+        ///
+        /// Searches a subtree for points nearer than the furthest found so far
+        /// \param unsigned int id - point searched from
+        /// \param double x - point searched from on x-axis
+        /// \param double y - point searched from on y-axis
+        /// \param unsigned int k - number of points to find
+        /// \param unsigned int low - first position of the subtree
+        /// \param unsigned int high - one past the last position
+        /// \param unsigned int depth - depth of the subtree's root
+        /// \param vector<Candidate>& heap - the nearest points found so far,
+        /// a max-heap of at most k with the furthest at the front
+        void searchNearest(unsigned int id, double x, double y, unsigned int k, unsigned int low,
+                           unsigned int high, unsigned int depth, std::vector<Candidate>& heap);
+
+        /// \brief
+        ///
+        /// Searches a subtree for points within a squared distance
+        /// \param unsigned int id - point searched from
+        /// \param double x - point searched from on x-axis
+        /// \param double y - point searched from on y-axis
+        /// \param double radius - greatest distance of a point found
+        /// \param unsigned int low - first position of the subtree
+        /// \param unsigned int high - one past the last position
+        /// \param unsigned int depth - depth of the subtree's root
+        /// \param vector<unsigned int>& found - the IDs of the points found
+        void searchWithin(unsigned int id, double x, double y, double radius, unsigned int low,
+                          unsigned int high, unsigned int depth, std::vector<unsigned int>& found);
+
+        /// \brief
+        ///
+        /// Offers a point to the nearest points found so far, keeping it
+        /// if fewer than k have been found or it is nearer than the furthest
+        /// \param unsigned int k - number of points to find
+        /// \param unsigned int position - position of the point in tree order
+        /// \param double x - point searched from on x-axis
+        /// \param double y - point searched from on y-axis
+        /// \param vector<Candidate>& heap - the nearest points found so far
+        void offer(unsigned int k, unsigned int position, double x, double y, std::vector<Candidate>& heap);
+
+        /// \brief
+        ///
+        /// Appends an edge for every pair found, once each however many
+        /// times it was found, sorted by source then destination
+        /// \param vector<vector<unsigned long long> >& pairs - pairs found by each
+        /// thread, the lower ID of each in the high half and the higher in the low
+        /// \param vector<WeightedEdge>& edges - collection the edges are appended to
+        void appendEdges(std::vector<std::vector<unsigned long long> >& pairs, std::vector<WeightedEdge>& edges);
+
+};
+
+#endif // _kdtree_h
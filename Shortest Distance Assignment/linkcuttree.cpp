@@ -0,0 +1,298 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: linkcuttree.cpp
+/// Implementation of LinkCutTree class
+/// Encapsulates a forest of rooted trees that can be joined and split,
+/// with the heaviest node on any path found in logarithmic time
+
+#include <cstddef>
+#include <limits>
+
+#include "linkcuttree.h"
+
+// Constant marking a missing child or parent
+const unsigned int NO_NODE = 0xFFFFFFFF;
+
+/// Encapsulates a link-cut tree of Sleator and Tarjan over the nodes
+/// [0, numNodes). The forest is split into preferred paths, each held in a
+/// splay tree ordered by depth, whose root points to the node above the
+/// path. Accessing a node makes the path up from it preferred, after which
+/// linking, cutting, testing whether two nodes are connected and finding
+/// the heaviest node on the path between them each take amortized
+/// O(log N) time. Nodes are keyed by a weight and then an order, so keys are
+/// never equal, an edge of a graph is represented by a node of its own
+/// between the nodes of its end points, and vertices by nodes keyed lower
+/// than any edge so the heaviest node on a path is always an edge
+
+/// \brief
+///
+/// Constructor, initializes an empty forest
+LinkCutTree::LinkCutTree(){
+}
+
+/// \brief
+///
+/// Destructor, no objects dynamically created from this class
+LinkCutTree::~LinkCutTree(){
+}
+
+/// \brief
+///
+/// Replaces the forest with nodes that are each a tree of their own,
+/// keyed lower than any weight
+/// \param unsigned int numNodes - number of nodes
+void LinkCutTree::reset(unsigned int numNodes){
+    Node node;
+    node.left = NO_NODE;
+    node.right = NO_NODE;
+    node.parent = NO_NODE;
+    node.reversed = false;
+    node.weight = -std::numeric_limits<double>::infinity();
+    node.order = 0;
+    nodes.assign(numNodes, node);
+    for (unsigned int x = 0; x < numNodes; x++) {
+        nodes[x].order = x;
+        nodes[x].heaviest = x;
+    }
+}
+
+/// \brief
+///
+/// Sets the key of a node
+/// \pre - the node is a tree of its own
+/// \param unsigned int node - node
+/// \param double weight - weight, compared first
+/// \param unsigned int order - order, compared between equal weights
+void LinkCutTree::setKey(unsigned int node, double weight, unsigned int order){
+    nodes[node].weight = weight;
+    nodes[node].order = order;
+    nodes[node].heaviest = node;
+}
+
+/// \brief
+///
+/// Makes a node the child of another without restructuring, for
+/// building a forest top down in linear time
+/// \pre - the node is the root of its tree and has not been accessed
+/// since the forest was reset, and its parent is in another tree
+/// \param unsigned int node - node
+/// \param unsigned int parent - its new parent
+void LinkCutTree::attach(unsigned int node, unsigned int parent){
+    // Every node is still a preferred path of its own, so the
+    // pointer to the node above the path is all there is to set
+    nodes[node].parent = parent;
+}
+
+/// \brief
+///
+/// Joins the trees of two nodes by an edge between them
+/// \pre - the nodes are in different trees
+/// \param unsigned int u - first node
+/// \param unsigned int v - second node
+void LinkCutTree::link(unsigned int u, unsigned int v){
+    makeRoot(u);
+    nodes[u].parent = v;
+}
+
+/// \brief
+///
+/// Splits a tree by removing the edge between two nodes
+/// \pre - the nodes are joined by an edge
+/// \param unsigned int u - first node
+/// \param unsigned int v - second node
+void LinkCutTree::cut(unsigned int u, unsigned int v){
+
+    // With u the root, accessing v leaves a path of just u and v,
+    // u the left child of v in their splay tree
+    makeRoot(u);
+    access(v);
+    nodes[v].left = NO_NODE;
+    nodes[u].parent = NO_NODE;
+    update(v);
+}
+
+/// \brief
+///
+/// Checks whether two nodes are in the same tree
+/// \param unsigned int u - first node
+/// \param unsigned int v - second node
+/// \return bool - true if connected
+bool LinkCutTree::connected(unsigned int u, unsigned int v){
+    return u == v || findRoot(u) == findRoot(v);
+}
+
+/// \brief
+///
+/// Finds the node with the greatest key on the path between two nodes
+/// \pre - the nodes are in the same tree
+/// \param unsigned int u - first node
+/// \param unsigned int v - second node
+/// \return unsigned int - heaviest node on the path, both ends included
+unsigned int LinkCutTree::pathMaximum(unsigned int u, unsigned int v){
+    makeRoot(u);
+    access(v);
+    return nodes[v].heaviest;
+}
+
+/// \brief
+///
+/// Makes the path from the root of a node's tree down to the node
+/// preferred, ending there, with the node at the root of its splay tree
+/// \param unsigned int - node
+void LinkCutTree::access(unsigned int x){
+
+    // Climb from path to path, each time replacing the lower part of the
+    // path above with the path climbed from
+    unsigned int below = NO_NODE;
+    for (unsigned int y = x; y != NO_NODE; y = nodes[y].parent) {
+        splay(y);
+        nodes[y].right = below;
+        update(y);
+        below = y;
+    }
+    splay(x);
+}
+
+/// \brief
+///
+/// Makes a node the root of its tree, reversing the path to the old root
+/// \param unsigned int - node
+void LinkCutTree::makeRoot(unsigned int x){
+    access(x);
+    nodes[x].reversed = !nodes[x].reversed;
+}
+
+/// \brief
+///
+/// Finds the root of a node's tree
+/// \param unsigned int - node
+/// \return unsigned int - root
+unsigned int LinkCutTree::findRoot(unsigned int x){
+
+    // The root is the shallowest node, the leftmost of the accessed path
+    access(x);
+    unsigned int root = x;
+    pushDown(root);
+    while (nodes[root].left != NO_NODE) {
+        root = nodes[root].left;
+        pushDown(root);
+    }
+    splay(root);
+    return root;
+}
+
+/// \brief
+///
+/// Moves a node to the root of its splay tree by rotations
+/// \param unsigned int - node
+void LinkCutTree::splay(unsigned int x){
+
+    // Pending reversals above the node are passed down first, from the top
+    unsigned int y = x;
+    above.clear();
+    above.push_back(y);
+    while (!isSplayRoot(y)) {
+        y = nodes[y].parent;
+        above.push_back(y);
+    }
+    for (size_t i = above.size(); i-- > 0; ) {
+        pushDown(above[i]);
+    }
+
+    while (!isSplayRoot(x)) {
+        unsigned int p = nodes[x].parent;
+        if (!isSplayRoot(p)) {
+            unsigned int g = nodes[p].parent;
+            bool zigZig = (nodes[g].left == p) == (nodes[p].left == x);
+            rotate(zigZig ? p : x);
+        }
+        rotate(x);
+    }
+}
+
+/// \brief
+///
+/// Rotates a node above its parent in its splay tree
+/// \param unsigned int - node
+void LinkCutTree::rotate(unsigned int x){
+
+    unsigned int p = nodes[x].parent;
+    unsigned int g = nodes[p].parent;
+
+    // The grandparent keeps pointing to whichever of the two is on top,
+    // as a child if it is in the same splay tree, otherwise as the path above
+    if (!isSplayRoot(p)) {
+        if (nodes[g].left == p) {
+            nodes[g].left = x;
+        } else {
+            nodes[g].right = x;
+        }
+    }
+    nodes[x].parent = g;
+
+    if (nodes[p].left == x) {
+        nodes[p].left = nodes[x].right;
+        if (nodes[x].right != NO_NODE) nodes[nodes[x].right].parent = p;
+        nodes[x].right = p;
+    } else {
+        nodes[p].right = nodes[x].left;
+        if (nodes[x].left != NO_NODE) nodes[nodes[x].left].parent = p;
+        nodes[x].left = p;
+    }
+    nodes[p].parent = x;
+
+    update(p);
+    update(x);
+}
+
+/// \brief
+///
+/// Checks whether a node is the root of its splay tree
+/// \param unsigned int - node
+/// \return bool - true if its parent, if any, is above its path
+bool LinkCutTree::isSplayRoot(unsigned int x){
+    unsigned int p = nodes[x].parent;
+    return p == NO_NODE || (nodes[p].left != x && nodes[p].right != x);
+}
+
+/// \brief
+///
+/// Passes a pending reversal of a node's subtree down to its children
+/// \param unsigned int - node
+void LinkCutTree::pushDown(unsigned int x){
+    Node& node = nodes[x];
+    if (!node.reversed) return;
+
+    unsigned int swapped = node.left;
+    node.left = node.right;
+    node.right = swapped;
+    if (node.left != NO_NODE) nodes[node.left].reversed = !nodes[node.left].reversed;
+    if (node.right != NO_NODE) nodes[node.right].reversed = !nodes[node.right].reversed;
+    node.reversed = false;
+}
+
+/// \brief
+///
+/// Recalculates the heaviest node of a node's subtree from its children
+/// \param unsigned int - node
+void LinkCutTree::update(unsigned int x){
+    Node& node = nodes[x];
+    node.heaviest = x;
+    if (node.left != NO_NODE && heavier(nodes[node.left].heaviest, node.heaviest)) {
+        node.heaviest = nodes[node.left].heaviest;
+    }
+    if (node.right != NO_NODE && heavier(nodes[node.right].heaviest, node.heaviest)) {
+        node.heaviest = nodes[node.right].heaviest;
+    }
+}
+
+/// \brief
+///
+/// Compares the keys of two nodes
+/// \param unsigned int a - first node
+/// \param unsigned int b - second node
+/// \return bool - true if a's key is greater
+bool LinkCutTree::heavier(unsigned int a, unsigned int b){
+    return nodes[a].weight > nodes[b].weight ||
+           (nodes[a].weight == nodes[b].weight && nodes[a].order > nodes[b].order);
+}
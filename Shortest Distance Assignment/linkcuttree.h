@@ -0,0 +1,178 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: linkcuttree.h
+/// Header of LinkCutTree class
+/// Encapsulates a forest of rooted trees that can be joined and split,
+/// with the heaviest node on any path found in logarithmic time
+
+#ifndef _linkcuttree_h
+#define _linkcuttree_h
+
+#include <vector>
+
+/// Encapsulates a link-cut tree of Sleator and Tarjan over the nodes
+/// [0, numNodes). The forest is split into preferred paths, each held in a
+/// splay tree ordered by depth, whose root points to the node above the
+/// path. Accessing a node makes the path up from it preferred, after which
+/// linking, cutting, testing whether two nodes are connected and finding
+/// the heaviest node on the path between them each take amortized
+/// O(log N) time. Nodes are keyed by a weight and then an order, so keys are
+/// never equal, an edge of a graph is represented by a node of its own
+/// between the nodes of its end points, and vertices by nodes keyed lower
+/// than any edge so the heaviest node on a path is always an edge
+class LinkCutTree {
+
+    public:
+
+        /// \brief
+        ///
+        /// Constructor, initializes an empty forest
+        LinkCutTree();
+
+        /// \brief
+        ///
+        /// Destructor, no objects dynamically created from this class
+        ~LinkCutTree();
+
+        /// \brief
+        ///
+        /// Replaces the forest with nodes that are each a tree of their own,
+        /// keyed lower than any weight
+        /// \param unsigned int numNodes - number of nodes
+        void reset(unsigned int numNodes);
+
+        /// \brief
+        ///
+        /// Sets the key of a node
+        /// \pre - the node is a tree of its own
+        /// \param unsigned int node - node
+        /// \param double weight - weight, compared first
+        /// \param unsigned int order - order, compared between equal weights
+        void setKey(unsigned int node, double weight, unsigned int order);
+
+        /// \brief
+        ///
+        /// Makes a node the child of another without restructuring, for
+        /// building a forest top down in linear time
+        /// \pre - the node is the root of its tree and has not been accessed
+        /// since the forest was reset, and its parent is in another tree
+        /// \param unsigned int node - node
+        /// \param unsigned int parent - its new parent
+        void attach(unsigned int node, unsigned int parent);
+
+        /// \brief
+        ///
+        /// Joins the trees of two nodes by an edge between them
+        /// \pre - the nodes are in different trees
+        /// \param unsigned int u - first node
+        /// \param unsigned int v - second node
+        void link(unsigned int u, unsigned int v);
+
+        /// \brief
+        ///
+        /// Splits a tree by removing the edge between two nodes
+        /// \pre - the nodes are joined by an edge
+        /// \param unsigned int u - first node
+        /// \param unsigned int v - second node
+        void cut(unsigned int u, unsigned int v);
+
+        /// \brief
+        ///
+        /// Checks whether two nodes are in the same tree
+        /// \param unsigned int u - first node
+        /// \param unsigned int v - second node
+        /// \return bool - true if connected
+        bool connected(unsigned int u, unsigned int v);
+
+        /// \brief
+        ///
+        /// Finds the node with the greatest key on the path between two nodes
+        /// \pre - the nodes are in the same tree
+        /// \param unsigned int u - first node
+        /// \param unsigned int v - second node
+        /// \return unsigned int - heaviest node on the path, both ends included
+        unsigned int pathMaximum(unsigned int u, unsigned int v);
+
+    private:
+
+        // A node of the forest, its children and parent in its splay tree,
+        // or for the root of a splay tree the node above its path, whether
+        // its subtree is to be reversed, its key and the heaviest node of
+        // its subtree
+        struct Node {
+            unsigned int left;
+            unsigned int right;
+            unsigned int parent;
+            bool reversed;
+            double weight;
+            unsigned int order;
+            unsigned int heaviest;
+        };
+
+        // Instance variables storing the nodes, and the nodes
+        // above the one being splayed, kept to save reallocating
+        std::vector<Node> nodes;
+        std::vector<unsigned int> above;
+
+        /// \brief
+        ///
+        /// Makes the path from the root of a node's tree down to the node
+        /// preferred, ending there, with the node at the root of its splay tree
+        /// \param unsigned int - node
+        void access(unsigned int);
+
+        /// \brief
+        ///
+        /// Makes a node the root of its tree, reversing the path to the old root
+        /// \param unsigned int - node
+        void makeRoot(unsigned int);
+
+        /// \brief
+        ///
+        /// Finds the root of a node's tree
+        /// \param unsigned int - node
+        /// \return unsigned int - root
+        unsigned int findRoot(unsigned int);
+
+        /// \brief
+        ///
+        /// Moves a node to the root of its splay tree by rotations
+        /// \param unsigned int - node
+        void splay(unsigned int);
+
+        /// \brief
+        ///
+        /// Rotates a node above its parent in its splay tree
+        /// \param unsigned int - node
+        void rotate(unsigned int);
+
+        /// \brief
+        ///
+        /// Checks whether a node is the root of its splay tree
+        /// \param unsigned int - node
+        /// \return bool - true if its parent, if any, is above its path
+        bool isSplayRoot(unsigned int);
+
+        /// \brief
+        ///
+        /// Passes a pending reversal of a node's subtree down to its children
+        /// \param unsigned int - node
+        void pushDown(unsigned int);
+
+        /// \brief
+        ///
+        /// Recalculates the heaviest node of a node's subtree from its children
+        /// \param unsigned int - node
+        void update(unsigned int);
+
+        /// \brief
+        ///
+        /// Compares the keys of two nodes
+        /// \param unsigned int a - first node
+        /// \param unsigned int b - second node
+        /// \return bool - true if a's key is greater
+        bool heavier(unsigned int a, unsigned int b);
+
+};
+
+#endif // _linkcuttree_h
@@ -0,0 +1,206 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: outputwriter.cpp
+/// Implementation of OutputWriter class
+/// Encapsulates a buffered writer that formats numbers straight
+/// into a block of memory and hands it on in large pieces
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <unistd.h>
+
+#include "outputwriter.h"
+
+// Constant defining the number of characters buffered before a write
+const size_t BUFFER_SIZE = 1 << 20;
+
+// Constant defining the most characters the integer part of a double
+// can take in fixed notation, with its sign
+const size_t MAX_FIXED_DIGITS = 320;
+
+/// Encapsulates a buffered writer for large reports such as weight matrices
+/// and path listings. Integers and fixed precision decimals are formatted with
+/// std::to_chars directly into a reusable buffer, with none of the locale and
+/// format state a stream consults for every value, and the buffer is handed to
+/// a file descriptor or an output stream only when it fills or is flushed
+
+/// \brief
+///
+/// Constructor, initializes a writer to a file descriptor,
+/// which is not closed by the writer
+/// \param int - file descriptor to write to
+OutputWriter::OutputWriter(int fd){
+    this->fd = fd;
+    stream = NULL;
+    buffer.resize(BUFFER_SIZE);
+    used = 0;
+    good = true;
+}
+
+/// \brief
+///
+/// Constructor, initializes a writer to an output stream, for
+/// output that must stay in order with other writes to the stream
+/// \param ostream& - stream to write to
+OutputWriter::OutputWriter(std::ostream& out){
+    fd = -1;
+    stream = &out;
+    buffer.resize(BUFFER_SIZE);
+    used = 0;
+    good = true;
+}
+
+/// \brief
+///
+/// Destructor, flushes anything still buffered
+OutputWriter::~OutputWriter(){
+    flush();
+}
+
+/// \brief
+///
+/// Writes a string
+/// \param const char* - null terminated string
+void OutputWriter::write(const char* text){
+    write(text, std::strlen(text));
+}
+
+/// \brief
+///
+/// Writes a number of characters
+/// \param const char* text - first character
+/// \param size_t length - number of characters
+void OutputWriter::write(const char* text, size_t length){
+
+    // Text too long for the buffer goes straight out behind what is buffered
+    if (length > buffer.size()) {
+        flush();
+        send(text, length);
+        return;
+    }
+
+    std::memcpy(reserve(length), text, length);
+    used += length;
+}
+
+/// \brief
+///
+/// Writes a single character
+/// \param char - character
+void OutputWriter::write(char c){
+    *reserve(1) = c;
+    used++;
+}
+
+/// \brief
+///
+/// Writes an unsigned integer
+/// \param unsigned long long - integer
+void OutputWriter::writeInteger(unsigned long long value){
+    char* first = reserve(20);
+    used = std::to_chars(first, first + 20, value).ptr - buffer.data();
+}
+
+/// \brief
+///
+/// Writes a decimal number with a fixed number of digits after
+/// the point, right aligned in a field of a minimum width
+/// \param double value - number
+/// \param int precision - digits after the decimal point
+/// \param int width - minimum number of characters, padded with
+/// spaces on the left
+void OutputWriter::writeFixed(double value, int precision, int width){
+
+    size_t room = MAX_FIXED_DIGITS + precision + width;
+    char* first = reserve(room);
+    char* last = std::to_chars(first, first + room, value, std::chars_format::fixed, precision).ptr;
+
+    // Shift the digits right to pad the field, which is rarely more
+    // than a few characters so is cheaper than formatting elsewhere
+    size_t length = last - first;
+    if (length < (size_t) width) {
+        size_t padding = width - length;
+        std::memmove(first + padding, first, length);
+        std::memset(first, ' ', padding);
+        length = width;
+    }
+    used += length;
+}
+
+/// \brief
+///
+/// Writes a repeated character
+/// \param char c - character
+/// \param size_t count - number of times
+void OutputWriter::fill(char c, size_t count){
+    while (count > 0) {
+        size_t n = count < buffer.size() ? count : buffer.size();
+        std::memset(reserve(n), c, n);
+        used += n;
+        count -= n;
+    }
+}
+
+/// \brief
+///
+/// Hands everything buffered to the file descriptor or stream
+/// \return bool - true if every write so far has succeeded
+bool OutputWriter::flush(){
+    send(buffer.data(), used);
+    used = 0;
+    return good;
+}
+
+/// \brief
+///
+/// Simple getter for whether every write so far has succeeded
+/// \return bool - true if no write has failed
+bool OutputWriter::isGood(){
+    return good;
+}
+
+/// \brief
+///
+/// Flushes the buffer if fewer than a number of characters are free
+/// \param size_t - number of characters needed
+/// \return char* - where the characters are to be written
+char* OutputWriter::reserve(size_t length){
+    if (buffer.size() - used < length) {
+        flush();
+        if (buffer.size() < length) {
+            buffer.resize(length);
+        }
+    }
+    return buffer.data() + used;
+}
+
+/// \brief
+///
+/// Hands characters to the file descriptor or stream, doing nothing
+/// once a write has failed
+/// \param const char* text - first character
+/// \param size_t length - number of characters
+void OutputWriter::send(const char* text, size_t length){
+
+    if (length == 0 || !good) return;
+
+    if (stream != NULL) {
+        stream->write(text, length);
+        good = !stream->fail();
+        return;
+    }
+
+    // A write may take only part of the characters, or be interrupted
+    // before taking any, so keep going until all of them are taken
+    size_t written = 0;
+    while (written < length) {
+        ssize_t n = ::write(fd, text + written, length - written);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            good = false;
+            return;
+        }
+        written += n;
+    }
+}
@@ -0,0 +1,124 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: outputwriter.h
+/// Header of OutputWriter class
+/// Encapsulates a buffered writer that formats numbers straight
+/// into a block of memory and hands it on in large pieces
+
+#ifndef _outputwriter_h
+#define _outputwriter_h
+
+#include <iostream>
+#include <vector>
+
+/// Encapsulates a buffered writer for large reports such as weight matrices
+/// and path listings. Integers and fixed precision decimals are formatted with
+/// std::to_chars directly into a reusable buffer, with none of the locale and
+/// format state a stream consults for every value, and the buffer is handed to
+/// a file descriptor or an output stream only when it fills or is flushed
+class OutputWriter {
+
+    public:
+
+        /// \brief
+        ///
+        /// Constructor, initializes a writer to a file descriptor,
+        /// which is not closed by the writer
+        /// \param int - file descriptor to write to
+        OutputWriter(int);
+
+        /// \brief
+        ///
+        /// Constructor, initializes a writer to an output stream, for
+        /// output that must stay in order with other writes to the stream
+        /// \param ostream& - stream to write to
+        OutputWriter(std::ostream&);
+
+        /// \brief
+        ///
+        /// Destructor, flushes anything still buffered
+        ~OutputWriter();
+
+        /// \brief
+        ///
+        /// Writes a string
+        /// \param const char* - null terminated string
+        void write(const char*);
+
+        /// \brief
+        ///
+        /// Writes a number of characters
+        /// \param const char* text - first character
+        /// \param size_t length - number of characters
+        void write(const char* text, size_t length);
+
+        /// \brief
+        ///
+        /// Writes a single character
+        /// \param char - character
+        void write(char);
+
+        /// \brief
+        ///
+        /// Writes an unsigned integer
+        /// \param unsigned long long - integer
+        void writeInteger(unsigned long long);
+
+        /// \brief
+        ///
+        /// Writes a decimal number with a fixed number of digits after
+        /// the point, right aligned in a field of a minimum width
+        /// \param double value - number
+        /// \param int precision - digits after the decimal point
+        /// \param int width - minimum number of characters, padded with
+        /// spaces on the left
+        void writeFixed(double value, int precision, int width);
+
+        /// \brief
+        ///
+        /// Writes a repeated character
+        /// \param char c - character
+        /// \param size_t count - number of times
+        void fill(char c, size_t count);
+
+        /// \brief
+        ///
+        /// Hands everything buffered to the file descriptor or stream
+        /// \return bool - true if every write so far has succeeded
+        bool flush();
+
+        /// \brief
+        ///
+        /// Simple getter for whether every write so far has succeeded
+        /// \return bool - true if no write has failed
+        bool isGood();
+
+    private:
+
+        // Instance variables storing the file descriptor or the stream
+        // written to, the buffer and the number of characters in it, and
+        // whether a write has failed
+        int fd;
+        std::ostream* stream;
+        std::vector<char> buffer;
+        size_t used;
+        bool good;
+
+        /// \brief
+        ///
+        /// Flushes the buffer if fewer than a number of characters are free
+        /// \param size_t - number of characters needed
+        /// \return char* - where the characters are to be written
+        char* reserve(size_t);
+
+        /// \brief
+        ///
+        /// Hands characters to the file descriptor or stream, doing nothing
+        /// once a write has failed
+        /// \param const char* text - first character
+        /// \param size_t length - number of characters
+        void send(const char* text, size_t length);
+
+};
+
+#endif // _outputwriter_h
@@ -6,9 +6,8 @@
 /// 2D space and a method for calculating distance
 /// between points
 
-#include <cmath>
-
 #include "point.h"
+#include "pointset.h"
 
 /// Encapsulates x and y coordinates to emulate a point in 2 dimensional
 /// space, also contains method for calculating distance between points
@@ -28,9 +27,23 @@ Point::Point(double x, double y) {
 /// Calculates Euclidean distance between this point to another
 /// \param Point* - pointer to the other Point
 double Point::distanceTo(Point* other) {
-   double dx = x - other->x;
-   double dy = y - other->y;
-   return sqrt(dx * dx + dy * dy);
+   return PointSet::distance(x, y, other->x, other->y);
+}
+
+/// \brief
+///
+/// Simple getter for the point on the x-axis
+/// \return double - x coordinate
+double Point::getX() {
+   return x;
+}
+
+/// \brief
+///
+/// Simple getter for the point on the y-axis
+/// \return double - y coordinate
+double Point::getY() {
+   return y;
 }
 
 
@@ -30,6 +30,18 @@ class Point {
         /// \param Point* - pointer to the other Point
         double distanceTo(Point*);
 
+        /// \brief
+        ///
+        /// Simple getter for the point on the x-axis
+        /// \return double - x coordinate
+        double getX();
+
+        /// \brief
+        ///
+        /// Simple getter for the point on the y-axis
+        /// \return double - y coordinate
+        double getY();
+
         /// \brief
         ///
         /// Outstram operator overload
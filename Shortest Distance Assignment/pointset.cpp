@@ -0,0 +1,272 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: pointset.cpp
+/// Implementation of PointSet class
+/// Encapsulates the coordinates of many points in two
+/// contiguous arrays, with vectorised bulk distance methods
+
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define POINTSET_X86
+#endif
+
+#include "pointset.h"
+
+// Every distance in this file is calculated as a product, a second product,
+// their sum and its square root, each rounded in turn. Fusing a product and
+// the sum into one multiply-add, as the compiler may where the instruction
+// exists, would round differently between the scalar and vector calculations
+#pragma GCC optimize("fp-contract=off")
+
+// Constant defining the most destinations weighEdges gathers
+// from a run of edges before measuring the distances to them
+const unsigned int GATHER_BLOCK = 256;
+
+/// Encapsulates the x and y coordinates of many points, each in its own
+/// contiguous array, so distances from one point to a run of others are
+/// calculated several at a time by SIMD instructions. The widest of AVX-512,
+/// AVX2 and SSE2 the processor supports is chosen when first needed. Every
+/// distance is rounded exactly as Point::distanceTo rounds it, which shares
+/// the scalar calculation, so bulk and single distances can be mixed freely
+
+/// \brief
+///
+/// Constructor, initializes an empty set
+PointSet::PointSet(){
+}
+
+/// \brief
+///
+/// Destructor, no objects dynamically created from this class
+PointSet::~PointSet(){
+}
+
+/// \brief
+///
+/// Adds a point to the end of the set
+/// \param double x - point on x-axis
+/// \param double y - point on y-axis
+void PointSet::add(double x, double y){
+    xs.push_back(x);
+    ys.push_back(y);
+}
+
+/// \brief
+///
+/// Adds a copy of a point to the end of the set
+/// \param Point* - pointer to the point
+void PointSet::add(Point* point){
+    add(point->getX(), point->getY());
+}
+
+/// \brief
+///
+/// Makes room for a number of points without reallocating
+/// \param unsigned int - number of points
+void PointSet::reserve(unsigned int count){
+    xs.reserve(count);
+    ys.reserve(count);
+}
+
+/// \brief
+///
+/// Simple getter for the number of points
+/// \return unsigned int - number of points
+unsigned int PointSet::getSize(){
+    return xs.size();
+}
+
+/// \brief
+///
+/// Simple getter for the x coordinates of every point
+/// \return const double* - x coordinate of the first point
+const double* PointSet::getXs(){
+    return xs.data();
+}
+
+/// \brief
+///
+/// Simple getter for the y coordinates of every point
+/// \return const double* - y coordinate of the first point
+const double* PointSet::getYs(){
+    return ys.data();
+}
+
+/// \brief
+///
+/// Calculates the distance between two points of the set
+/// \param unsigned int i - first point's index
+/// \param unsigned int j - second point's index
+/// \return double - distance
+double PointSet::distanceBetween(unsigned int i, unsigned int j){
+    return distance(xs[i], ys[i], xs[j], ys[j]);
+}
+
+/// \brief
+///
+/// Calculates the distances from one point to a run of points
+/// \param unsigned int i - index of the point to measure from
+/// \param unsigned int first - index of the first point to measure to
+/// \param unsigned int last - one past the index of the last point
+/// \param double* distances - filled with last - first distances
+void PointSet::distancesFrom(unsigned int i, unsigned int first, unsigned int last, double* distances){
+    if (first < last) {
+        getKernel()(xs[i], ys[i], xs.data() + first, ys.data() + first, last - first, distances);
+    }
+}
+
+/// \brief
+///
+/// Weighs edges between points of the set by the distance between
+/// their end points, the destinations of each run of edges from the
+/// same source gathered together and measured several at a time
+/// \param WeightedEdge* edges - first edge to be weighed
+/// \param unsigned int count - number of edges
+void PointSet::weighEdges(WeightedEdge* edges, unsigned int count){
+
+    Kernel kernel = getKernel();
+    double gatheredXs[GATHER_BLOCK];
+    double gatheredYs[GATHER_BLOCK];
+    double distances[GATHER_BLOCK];
+
+    unsigned int first = 0;
+    while (first < count) {
+        unsigned int source = edges[first].source;
+        unsigned int last = first;
+        while (last < count && last - first < GATHER_BLOCK && edges[last].source == source) {
+            gatheredXs[last - first] = xs[edges[last].destination];
+            gatheredYs[last - first] = ys[edges[last].destination];
+            last++;
+        }
+
+        kernel(xs[source], ys[source], gatheredXs, gatheredYs, last - first, distances);
+        for (unsigned int e = first; e < last; e++) {
+            edges[e].weight = distances[e - first];
+        }
+        first = last;
+    }
+}
+
+/// \brief
+///
+/// Calculates the straight line distance between two points, the
+/// calculation Point::distanceTo and every bulk method round alike
+/// \param double x1 - first point on x-axis
+/// \param double y1 - first point on y-axis
+/// \param double x2 - second point on x-axis
+/// \param double y2 - second point on y-axis
+/// \return double - distance
+double PointSet::distance(double x1, double y1, double x2, double y2){
+    double dx = x1 - x2;
+    double dy = y1 - y2;
+    return sqrt(dx * dx + dy * dy);
+}
+
+/// \brief
+///
+/// Simple getter for the instruction set the bulk methods use
+/// \return const char* - "avx512f", "avx2" or "sse2"
+const char* PointSet::getInstructionSet(){
+    Kernel kernel = getKernel();
+    if (kernel == distancesAvx512) return "avx512f";
+    if (kernel == distancesAvx2) return "avx2";
+#ifdef POINTSET_X86
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+/// \brief
+///
+/// Chooses the widest bulk distance calculation the processor
+/// supports, the first time it is called
+/// \return Kernel - the calculation to use
+PointSet::Kernel PointSet::getKernel(){
+
+    // Initialized once even when several threads get here first together
+    static const Kernel kernel = []() {
+#ifdef POINTSET_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return distancesAvx512;
+        if (__builtin_cpu_supports("avx2")) return distancesAvx2;
+#endif
+        return distancesSse2;
+    }();
+    return kernel;
+}
+
+/// \brief
+///
+/// Bulk distance calculations from one point to a number of points,
+/// eight, four or two at a time, finishing any remainder one at a time
+/// \param double x - point on x-axis to measure from
+/// \param double y - point on y-axis to measure from
+/// \param const double* xs - x coordinates of the points to measure to
+/// \param const double* ys - y coordinates of the points to measure to
+/// \param unsigned int count - number of points to measure to
+/// \param double* distances - filled with the distances
+#ifdef POINTSET_X86
+__attribute__((target("avx512f")))
+#endif
+void PointSet::distancesAvx512(double x, double y, const double* xs, const double* ys, unsigned int count,
+                               double* distances){
+
+    unsigned int k = 0;
+#ifdef POINTSET_X86
+    __m512d px = _mm512_set1_pd(x);
+    __m512d py = _mm512_set1_pd(y);
+    for (; k + 8 <= count; k += 8) {
+        __m512d dx = _mm512_sub_pd(px, _mm512_loadu_pd(xs + k));
+        __m512d dy = _mm512_sub_pd(py, _mm512_loadu_pd(ys + k));
+        __m512d squared = _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy));
+        _mm512_storeu_pd(distances + k, _mm512_sqrt_pd(squared));
+    }
+#endif
+    for (; k < count; k++) {
+        distances[k] = distance(x, y, xs[k], ys[k]);
+    }
+}
+
+#ifdef POINTSET_X86
+__attribute__((target("avx2")))
+#endif
+void PointSet::distancesAvx2(double x, double y, const double* xs, const double* ys, unsigned int count,
+                             double* distances){
+
+    unsigned int k = 0;
+#ifdef POINTSET_X86
+    __m256d px = _mm256_set1_pd(x);
+    __m256d py = _mm256_set1_pd(y);
+    for (; k + 4 <= count; k += 4) {
+        __m256d dx = _mm256_sub_pd(px, _mm256_loadu_pd(xs + k));
+        __m256d dy = _mm256_sub_pd(py, _mm256_loadu_pd(ys + k));
+        __m256d squared = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        _mm256_storeu_pd(distances + k, _mm256_sqrt_pd(squared));
+    }
+#endif
+    for (; k < count; k++) {
+        distances[k] = distance(x, y, xs[k], ys[k]);
+    }
+}
+
+void PointSet::distancesSse2(double x, double y, const double* xs, const double* ys, unsigned int count,
+                             double* distances){
+
+    unsigned int k = 0;
+#ifdef POINTSET_X86
+    __m128d px = _mm_set1_pd(x);
+    __m128d py = _mm_set1_pd(y);
+    for (; k + 2 <= count; k += 2) {
+        __m128d dx = _mm_sub_pd(px, _mm_loadu_pd(xs + k));
+        __m128d dy = _mm_sub_pd(py, _mm_loadu_pd(ys + k));
+        __m128d squared = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        _mm_storeu_pd(distances + k, _mm_sqrt_pd(squared));
+    }
+#endif
+    for (; k < count; k++) {
+        distances[k] = distance(x, y, xs[k], ys[k]);
+    }
+}
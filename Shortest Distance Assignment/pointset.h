@@ -0,0 +1,153 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: pointset.h
+/// Header of PointSet class
+/// Encapsulates the coordinates of many points in two
+/// contiguous arrays, with vectorised bulk distance methods
+
+#ifndef _pointset_h
+#define _pointset_h
+
+#include <vector>
+
+#include "point.h"
+#include "edge.h"
+
+/// Encapsulates the x and y coordinates of many points, each in its own
+/// contiguous array, so distances from one point to a run of others are
+/// calculated several at a time by SIMD instructions. The widest of AVX-512,
+/// AVX2 and SSE2 the processor supports is chosen when first needed. Every
+/// distance is rounded exactly as Point::distanceTo rounds it, which shares
+/// the scalar calculation, so bulk and single distances can be mixed freely
+class PointSet {
+
+    public:
+
+        /// \brief
+        ///
+        /// Constructor, initializes an empty set
+        PointSet();
+
+        /// \brief
+        ///
+        /// Destructor, no objects dynamically created from this class
+        ~PointSet();
+
+        /// \brief
+        ///
+        /// Adds a point to the end of the set
+        /// \param double x - point on x-axis
+        /// \param double y - point on y-axis
+        void add(double x, double y);
+
+        /// \brief
+        ///
+        /// Adds a copy of a point to the end of the set
+        /// \param Point* - pointer to the point
+        void add(Point*);
+
+        /// \brief
+        ///
+        /// Makes room for a number of points without reallocating
+        /// \param unsigned int - number of points
+        void reserve(unsigned int);
+
+        /// \brief
+        ///
+        /// Simple getter for the number of points
+        /// \return unsigned int - number of points
+        unsigned int getSize();
+
+        /// \brief
+        ///
+        /// Simple getter for the x coordinates of every point
+        /// \return const double* - x coordinate of the first point
+        const double* getXs();
+
+        /// \brief
+        ///
+        /// Simple getter for the y coordinates of every point
+        /// \return const double* - y coordinate of the first point
+        const double* getYs();
+
+        /// \brief
+        ///
+        /// Calculates the distance between two points of the set
+        /// \param unsigned int i - first point's index
+        /// \param unsigned int j - second point's index
+        /// \return double - distance
+        double distanceBetween(unsigned int i, unsigned int j);
+
+        /// \brief
+        ///
+        /// Calculates the distances from one point to a run of points
+        /// \param unsigned int i - index of the point to measure from
+        /// \param unsigned int first - index of the first point to measure to
+        /// \param unsigned int last - one past the index of the last point
+        /// \param double* distances - filled with last - first distances
+        void distancesFrom(unsigned int i, unsigned int first, unsigned int last, double* distances);
+
+        /// \brief
+        ///
+        /// Weighs edges between points of the set by the distance between
+        /// their end points, the destinations of each run of edges from the
+        /// same source gathered together and measured several at a time
+        /// \param WeightedEdge* edges - first edge to be weighed
+        /// \param unsigned int count - number of edges
+        void weighEdges(WeightedEdge* edges, unsigned int count);
+
+        /// \brief
+        ///
+        /// Calculates the straight line distance between two points, the
+        /// calculation Point::distanceTo and every bulk method round alike
+        /// \param double x1 - first point on x-axis
+        /// \param double y1 - first point on y-axis
+        /// \param double x2 - second point on x-axis
+        /// \param double y2 - second point on y-axis
+        /// \return double - distance
+        static double distance(double x1, double y1, double x2, double y2);
+
+        /// \brief
+        ///
+        /// Simple getter for the instruction set the bulk methods use
+        /// \return const char* - "avx512f", "avx2" or "sse2"
+        static const char* getInstructionSet();
+
+    private:
+
+        // Signature shared by the bulk distance calculations, from one point
+        // to a number of points given by their coordinate arrays
+        typedef void (*Kernel)(double x, double y, const double* xs, const double* ys, unsigned int count,
+                               double* distances);
+
+        // Instance variables storing the x and y coordinates of every point
+        std::vector<double> xs;
+        std::vector<double> ys;
+
+        /// \brief
+        ///
+        /// Chooses the widest bulk distance calculation the processor
+        /// supports, the first time it is called
+        /// \return Kernel - the calculation to use
+        static Kernel getKernel();
+
+        /// \brief
+        ///
+        /// Bulk distance calculations from one point to a number of points,
+        /// eight, four or two at a time, finishing any remainder one at a time
+        /// \param double x - point on x-axis to measure from
+        /// \param double y - point on y-axis to measure from
+        /// \param const double* xs - x coordinates of the points to measure to
+        /// \param const double* ys - y coordinates of the points to measure to
+        /// \param unsigned int count - number of points to measure to
+        /// \param double* distances - filled with the distances
+        static void distancesAvx512(double x, double y, const double* xs, const double* ys, unsigned int count,
+                                    double* distances);
+        static void distancesAvx2(double x, double y, const double* xs, const double* ys, unsigned int count,
+                                  double* distances);
+        static void distancesSse2(double x, double y, const double* xs, const double* ys, unsigned int count,
+                                  double* distances);
+
+};
+
+#endif // _pointset_h
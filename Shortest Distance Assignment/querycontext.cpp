@@ -0,0 +1,158 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: querycontext.cpp
+/// Implementation of QueryContext class
+/// Encapsulates the working state of shortest path queries,
+/// kept apart from the graph so many queries can run at once
+
+#include <algorithm>
+
+#include "querycontext.h"
+#include "graph.h"
+
+/// Encapsulates the working state of one shortest path query at a time: the
+/// distance, predecessor and discovered state of every vertex, held in arrays
+/// rather than in the vertices, for the search from the source and for the
+/// search from the target of bidirectional queries, with their queues.
+/// Each query stamps the entries it writes with a new epoch and entries with
+/// an older stamp read as unreached, so starting a query costs nothing however
+/// many vertices the last one reached. A graph or contraction hierarchy only
+/// reads itself during a query, so threads sharing one each query it with
+/// their own context
+
+/// \brief
+///
+/// No argument constructor, initializes a context that
+/// holds no vertices until resized
+QueryContext::QueryContext(){
+    resize(0);
+}
+
+/// \brief
+///
+/// Constructor, initializes a context for a number of vertices
+/// \param unsigned int - number of vertices
+QueryContext::QueryContext(unsigned int N){
+    resize(N);
+}
+
+/// \brief
+///
+/// Destructor, no objects dynamically created from this class
+QueryContext::~QueryContext(){
+}
+
+/// \brief
+///
+/// Changes the number of vertices the context holds,
+/// forgetting the result of the last query
+/// \param unsigned int - number of vertices
+void QueryContext::resize(unsigned int N){
+    numVertices = N;
+    epoch = 1;
+    resizeSearch(forward);
+    resizeSearch(backward);
+}
+
+/// \brief
+///
+/// Simple getter for the number of vertices the context holds
+/// \return unsigned int - number of vertices
+unsigned int QueryContext::getNumVertices(){
+    return numVertices;
+}
+
+/// \brief
+///
+/// Simple getter for the source vertex of the last query
+/// \return unsigned int - source vertex's ID
+unsigned int QueryContext::getSource(){
+    return forward.origin;
+}
+
+/// \brief
+///
+/// Simple getter for the distance from the source of the last query
+/// \param unsigned int - vertex's ID
+/// \return double - distance, INFINITY if the vertex was not reached
+double QueryContext::getDistance(unsigned int v){
+    return forward.reached[v] == epoch ? forward.distance[v] : INFINITY;
+}
+
+/// \brief
+///
+/// Simple getter for the vertex preceding a vertex on its path
+/// from the source of the last query
+/// \param unsigned int - vertex's ID
+/// \return unsigned int - preceding vertex's ID, the vertex itself
+/// for the source and for vertices that were not reached
+unsigned int QueryContext::getPredecessorId(unsigned int v){
+    return forward.reached[v] == epoch ? forward.predecessor[v] : v;
+}
+
+/// \brief
+///
+/// Simple getter for whether the last query settled a vertex
+/// \param unsigned int - vertex's ID
+/// \return bool - true if discovered
+bool QueryContext::isDiscovered(unsigned int v){
+    return forward.settled[v] == epoch;
+}
+
+/// \brief
+///
+/// Starts a new query by moving to the next epoch, only clearing
+/// the stamps when the epoch counter wraps around, and reaches the
+/// vertices the forward and backward searches start from at distance 0
+/// \param unsigned int N - number of vertices of the graph searched,
+/// the context is resized if it holds a different number
+/// \param unsigned int source - vertex the forward search starts from
+/// \param unsigned int target - vertex the backward search starts from
+void QueryContext::start(unsigned int N, unsigned int source, unsigned int target){
+
+    if (N != numVertices) {
+        resize(N);
+    }
+
+    // Stamps start at 0 below the first epoch, so nothing reads as reached
+    epoch++;
+    if (epoch == 0) {
+        std::fill(forward.reached.begin(), forward.reached.end(), 0);
+        std::fill(forward.settled.begin(), forward.settled.end(), 0);
+        std::fill(backward.reached.begin(), backward.reached.end(), 0);
+        std::fill(backward.settled.begin(), backward.settled.end(), 0);
+        epoch = 1;
+    }
+
+    // A query that stopped early can leave entries in the queues
+    forward.queue.clear();
+    backward.queue.clear();
+
+    startSearch(forward, source);
+    startSearch(backward, target);
+}
+
+/// \brief
+///
+/// Reaches the vertex a search starts from at distance 0
+/// \param Search& - search to be started
+/// \param unsigned int - vertex the search starts from
+void QueryContext::startSearch(Search& search, unsigned int origin){
+    search.origin = origin;
+    search.distance[origin] = 0;
+    search.predecessor[origin] = origin;
+    search.reached[origin] = epoch;
+}
+
+/// \brief
+///
+/// Sizes the arrays of one search
+/// \param Search& - search to be sized
+void QueryContext::resizeSearch(Search& search){
+    search.distance.assign(numVertices, INFINITY);
+    search.predecessor.assign(numVertices, 0);
+    search.reached.assign(numVertices, 0);
+    search.settled.assign(numVertices, 0);
+    search.origin = 0;
+    search.queue.resize(numVertices);
+}
@@ -0,0 +1,137 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: querycontext.h
+/// Header of QueryContext class
+/// Encapsulates the working state of shortest path queries,
+/// kept apart from the graph so many queries can run at once
+
+#ifndef _querycontext_h
+#define _querycontext_h
+
+#include <vector>
+
+#include "indexedheap.h"
+
+/// Encapsulates the working state of one shortest path query at a time: the
+/// distance, predecessor and discovered state of every vertex, held in arrays
+/// rather than in the vertices, for the search from the source and for the
+/// search from the target of bidirectional queries, with their queues.
+/// Each query stamps the entries it writes with a new epoch and entries with
+/// an older stamp read as unreached, so starting a query costs nothing however
+/// many vertices the last one reached. A graph or contraction hierarchy only
+/// reads itself during a query, so threads sharing one each query it with
+/// their own context
+class QueryContext {
+
+    public:
+
+        /// \brief
+        ///
+        /// No argument constructor, initializes a context that
+        /// holds no vertices until resized
+        QueryContext();
+
+        /// \brief
+        ///
+        /// Constructor, initializes a context for a number of vertices
+        /// \param unsigned int - number of vertices
+        QueryContext(unsigned int);
+
+        /// \brief
+        ///
+        /// Destructor, no objects dynamically created from this class
+        ~QueryContext();
+
+        /// \brief
+        ///
+        /// Changes the number of vertices the context holds,
+        /// forgetting the result of the last query
+        /// \param unsigned int - number of vertices
+        void resize(unsigned int);
+
+        /// \brief
+        ///
+        /// Simple getter for the number of vertices the context holds
+        /// \return unsigned int - number of vertices
+        unsigned int getNumVertices();
+
+        /// \brief
+        ///
+        /// Simple getter for the source vertex of the last query
+        /// \return unsigned int - source vertex's ID
+        unsigned int getSource();
+
+        /// \brief
+        ///
+        /// Simple getter for the distance from the source of the last query
+        /// \param unsigned int - vertex's ID
+        /// \return double - distance, INFINITY if the vertex was not reached
+        double getDistance(unsigned int);
+
+        /// \brief
+        ///
+        /// Simple getter for the vertex preceding a vertex on its path
+        /// from the source of the last query
+        /// \param unsigned int - vertex's ID
+        /// \return unsigned int - preceding vertex's ID, the vertex itself
+        /// for the source and for vertices that were not reached
+        unsigned int getPredecessorId(unsigned int);
+
+        /// \brief
+        ///
+        /// Simple getter for whether the last query settled a vertex
+        /// \param unsigned int - vertex's ID
+        /// \return bool - true if discovered
+        bool isDiscovered(unsigned int);
+
+    private:
+
+        friend class Graph;
+        friend class ContractionHierarchy;
+
+        // Working state of a search from one end, the distance and
+        // predecessor of every vertex, the epoch each was reached and
+        // settled in, the vertex the search started from and its queue
+        struct Search {
+            std::vector<double> distance;
+            std::vector<unsigned int> predecessor;
+            std::vector<unsigned int> reached;
+            std::vector<unsigned int> settled;
+            unsigned int origin;
+            IndexedHeap queue;
+        };
+
+        // Instance variables storing the number of vertices, the searches
+        // from the source and from the target, and the epoch of the current query
+        unsigned int numVertices;
+        Search forward;
+        Search backward;
+        unsigned int epoch;
+
+        /// \brief
+        ///
+        /// Starts a new query by moving to the next epoch, only clearing
+        /// the stamps when the epoch counter wraps around, and reaches the
+        /// vertices the forward and backward searches start from at distance 0
+        /// \param unsigned int N - number of vertices of the graph searched,
+        /// the context is resized if it holds a different number
+        /// \param unsigned int source - vertex the forward search starts from
+        /// \param unsigned int target - vertex the backward search starts from
+        void start(unsigned int N, unsigned int source, unsigned int target);
+
+        /// \brief
+        ///
+        /// Reaches the vertex a search starts from at distance 0
+        /// \param Search& - search to be started
+        /// \param unsigned int - vertex the search starts from
+        void startSearch(Search&, unsigned int);
+
+        /// \brief
+        ///
+        /// Sizes the arrays of one search
+        /// \param Search& - search to be sized
+        void resizeSearch(Search&);
+
+};
+
+#endif // _querycontext_h
@@ -1,16 +1,30 @@
 /// Created by Phuc Tran 08908184
 ///
 /// File: random.cpp
-/// Header of Random class, contains private method for seeding
-/// randomizer and generating a random real number
-/// and methods for generating random integers and probability
+/// Header of Random class, contains private methods for seeding
+/// the generator and advancing its state and methods for generating
+/// random integers, real numbers and probability, singly or in bulk
 
-#include <cstdlib>
 #include <ctime>
 #include "random.h"
 
-/// This class provides functions for generating random integers
-/// and random probability
+// Constant scaling 53 random bits to a real number from 0 to 1
+const double REAL_SCALE = 1.0 / 9007199254740992.0;
+
+// Constants of the xoshiro256** jump, which advances the state
+// as far as 2^128 calls to randomBits would
+const uint64_t JUMP[4] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                           0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+
+/// This class provides functions for generating random integers,
+/// random real numbers and random probability
+///
+/// The numbers come from the xoshiro256** generator rather than rand(),
+/// so every Random has a state of its own. Given the same seed it
+/// produces the same numbers on every machine, and one Random per thread
+/// can be used together without locking. Randoms built from the same seed
+/// with different stream numbers are 2^128 numbers apart, so their
+/// numbers never overlap
 
 /// \brief
 ///
@@ -19,17 +33,51 @@ Random::Random() {
    randomize();
 }
 
+/// \brief
+///
+/// Constructor, initializes the randomizer with a seed to produce the
+/// same numbers every run
+/// \param uint64_t seed - any value
+Random::Random(uint64_t seed) {
+   this->seed(seed);
+}
+
+/// \brief
+///
+/// Constructor, initializes one of many independent streams of
+/// numbers from the same seed, e.g. one for every thread
+/// \param uint64_t seed - any value
+/// \param unsigned int stream - stream number, 0 gives the same
+/// numbers as Random(seed)
+Random::Random(uint64_t seed, unsigned int stream) {
+   this->seed(seed);
+   for (unsigned int i = 0; i < stream; i++) {
+      jump();
+   }
+}
+
 
 /// \brief
 ///
-/// Generates a random integer number greater than or equal to low and less than high.
+/// Generates a random integer number greater than or equal to low and less than or equal to high.
 /// \param low int - lower bound for range (inclusive)
-/// \param high int - upper bound for range (exclusive)
+/// \param high int - upper bound for range (inclusive)
 /// \return int - A random integer number between low and high
 int Random::randomInteger(int low, int high) {
-   double d = double(rand()) / (double(RAND_MAX) + 1);
-   int k = int(d * (high - low  + 1));
-   return low + k;
+   uint64_t bound = uint64_t(int64_t(high) - low) + 1;
+   return int(int64_t(low) + int64_t(randomBelow(bound)));
+}
+
+/// \brief
+///
+/// Generates a random real number greater than or equal to low and less than high
+///
+/// \param low double - lower bound for range (inclusive)
+/// \param high double - upper bound for range (exclusive)
+/// \return double - A random real number between low and high
+double Random::randomReal(double low, double high) {
+   double d = double(randomBits() >> 11) * REAL_SCALE;
+   return low + d * (high - low);
 }
 
 /// \brief
@@ -39,7 +87,92 @@ int Random::randomInteger(int low, int high) {
 /// \param double p - Value between 0 (never) and 1 (always)
 /// \return bool - true or false based on p
 bool Random::randomChance(double p) {
-   return randomReal(0, 1) < p;
+   return double(randomBits() >> 11) < chanceThreshold(p);
+}
+
+/// \brief
+///
+/// Fills an array with random integers, the same numbers as
+/// calling randomInteger once for each
+/// \param low int - lower bound for range (inclusive)
+/// \param high int - upper bound for range (inclusive)
+/// \param int* values - array to fill
+/// \param size_t count - number of values
+void Random::randomIntegers(int low, int high, int* values, size_t count) {
+   uint64_t bound = uint64_t(int64_t(high) - low) + 1;
+   for (size_t i = 0; i < count; i++) {
+      values[i] = int(int64_t(low) + int64_t(randomBelow(bound)));
+   }
+}
+
+/// \brief
+///
+/// Fills an array with random real numbers, the same numbers as
+/// calling randomReal once for each
+/// \param low double - lower bound for range (inclusive)
+/// \param high double - upper bound for range (exclusive)
+/// \param double* values - array to fill
+/// \param size_t count - number of values
+void Random::randomReals(double low, double high, double* values, size_t count) {
+   double range = high - low;
+   for (size_t i = 0; i < count; i++) {
+      values[i] = low + double(randomBits() >> 11) * REAL_SCALE * range;
+   }
+}
+
+/// \brief
+///
+/// Fills an array with true false outcomes, the same outcomes as
+/// calling randomChance once for each
+/// \param double p - Value between 0 (never) and 1 (always)
+/// \param bool* outcomes - array to fill
+/// \param size_t count - number of outcomes
+void Random::randomChances(double p, bool* outcomes, size_t count) {
+   double threshold = chanceThreshold(p);
+   for (size_t i = 0; i < count; i++) {
+      outcomes[i] = double(randomBits() >> 11) < threshold;
+   }
+}
+
+/// \brief
+///
+/// Generates the next 64 random bits, from which every other
+/// method's numbers are made
+/// \return uint64_t - random bits
+uint64_t Random::randomBits() {
+   uint64_t product = state[1] * 5;
+   uint64_t result = ((product << 7) | (product >> 57)) * 9;
+   uint64_t shifted = state[1] << 17;
+
+   state[2] ^= state[0];
+   state[3] ^= state[1];
+   state[1] ^= state[2];
+   state[0] ^= state[3];
+   state[2] ^= shifted;
+   state[3] = (state[3] << 45) | (state[3] >> 19);
+
+   return result;
+}
+
+/// \brief
+///
+/// Skips 2^128 numbers ahead, to a stream of numbers that
+/// does not overlap the numbers before the jump
+void Random::jump() {
+   uint64_t jumped[4] = { 0, 0, 0, 0 };
+   for (int word = 0; word < 4; word++) {
+      for (int bit = 0; bit < 64; bit++) {
+         if (JUMP[word] & (uint64_t(1) << bit)) {
+            for (int i = 0; i < 4; i++) {
+               jumped[i] ^= state[i];
+            }
+         }
+         randomBits();
+      }
+   }
+   for (int i = 0; i < 4; i++) {
+      state[i] = jumped[i];
+   }
 }
 
 /// \brief
@@ -47,18 +180,52 @@ bool Random::randomChance(double p) {
 /// Initializes the seed based on time to obtain different results
 /// with different runs
 void Random::randomize() {
-   srand(int(time(NULL)));
+   seed(uint64_t(time(NULL)));
 }
 
 /// \brief
 ///
-/// Helper method for randomChance
-/// Generates a random real number greater than or equal to low and less than high
+/// Initializes the state from a seed, spreading its bits with the
+/// splitmix64 generator so similar seeds give unrelated numbers
+/// \param uint64_t seed - any value
+void Random::seed(uint64_t seed) {
+   for (int i = 0; i < 4; i++) {
+      seed += 0x9e3779b97f4a7c15ULL;
+      uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      state[i] = z ^ (z >> 31);
+   }
+}
+
+/// \brief
 ///
-/// \param low double - lower bound for range (inclusive)
-/// \param high double - upper bound for range (exclusive)
-/// \return double - A random real number between low and high
-double Random::randomReal(double low, double high) {
-   double d = double(rand()) / (double(RAND_MAX) + 1);
-   return low + d * (high - low);
+/// Helper method for randomInteger and randomIntegers
+/// Generates a random integer less than a bound without bias,
+/// by multiplying random bits by it and rejecting the rare
+/// products that would favour some results
+/// \param uint64_t bound - number of possible results, at most 2^32
+/// \return uint64_t - A random integer from 0 to bound - 1
+uint64_t Random::randomBelow(uint64_t bound) {
+   unsigned __int128 product = (unsigned __int128)randomBits() * bound;
+   uint64_t low = uint64_t(product);
+   if (low < bound) {
+      uint64_t rejected = (0 - bound) % bound;
+      while (low < rejected) {
+         product = (unsigned __int128)randomBits() * bound;
+         low = uint64_t(product);
+      }
+   }
+   return uint64_t(product >> 64);
+}
+
+/// \brief
+///
+/// Helper method for randomChance and randomChances
+/// Works out the number 53 random bits must be below for an outcome
+/// to be true, so randomReal(0, 1) < p is decided without division
+/// \param double p - Value between 0 (never) and 1 (always)
+/// \return double - p scaled by 2^53
+double Random::chanceThreshold(double p) {
+   return p * 9007199254740992.0;
 }
@@ -1,17 +1,26 @@
 /// Created by Phuc Tran 08908184
 ///
 /// File: random.h
-/// Header of Random class, contains private method for seeding
-/// randomizer and generating a random real number
-/// and methods for generating random integers and probability
+/// Header of Random class, contains private methods for seeding
+/// the generator and advancing its state and methods for generating
+/// random integers, real numbers and probability, singly or in bulk
 
 #ifndef _random_h
 #define _random_h
 
+#include <cstddef>
+#include <cstdint>
 
-/// This class provides functions for generating random integers
-/// and random probability
+
+/// This class provides functions for generating random integers,
+/// random real numbers and random probability
 ///
+/// The numbers come from the xoshiro256** generator rather than rand(),
+/// so every Random has a state of its own. Given the same seed it
+/// produces the same numbers on every machine, and one Random per thread
+/// can be used together without locking. Randoms built from the same seed
+/// with different stream numbers are 2^128 numbers apart, so their
+/// numbers never overlap
 class Random {
     public:
 
@@ -20,15 +29,40 @@ class Random {
        /// Constructor, initializes the randomizer.
        Random();
 
+        /// \brief
+        ///
+        /// Constructor, initializes the randomizer with a seed to produce the
+        /// same numbers every run
+        /// \param uint64_t seed - any value
+        Random(uint64_t seed);
+
+        /// \brief
+        ///
+        /// Constructor, initializes one of many independent streams of
+        /// numbers from the same seed, e.g. one for every thread
+        /// \param uint64_t seed - any value
+        /// \param unsigned int stream - stream number, 0 gives the same
+        /// numbers as Random(seed)
+        Random(uint64_t seed, unsigned int stream);
+
 
         /// \brief
         ///
-        /// Generates a random integer number greater than or equal to low and less than high.
+        /// Generates a random integer number greater than or equal to low and less than or equal to high.
         /// \param low int - lower bound for range (inclusive)
-        /// \param high int - upper bound for range (exclusive)
+        /// \param high int - upper bound for range (inclusive)
         /// \return int - A random integer number between low and high
         int randomInteger(int low, int high);
 
+        /// \brief
+        ///
+        /// Generates a random real number greater than or equal to low and less than high
+        ///
+        /// \param low double - lower bound for range (inclusive)
+        /// \param high double - upper bound for range (exclusive)
+        /// \return double - A random real number between low and high
+        double randomReal(double low, double high);
+
 
         /// \brief
         /// Generates a true false outcome based on the probability
@@ -38,8 +72,53 @@ class Random {
         /// \return bool - true or false based on p
         bool randomChance(double p);
 
+        /// \brief
+        ///
+        /// Fills an array with random integers, the same numbers as
+        /// calling randomInteger once for each
+        /// \param low int - lower bound for range (inclusive)
+        /// \param high int - upper bound for range (inclusive)
+        /// \param int* values - array to fill
+        /// \param size_t count - number of values
+        void randomIntegers(int low, int high, int* values, size_t count);
+
+        /// \brief
+        ///
+        /// Fills an array with random real numbers, the same numbers as
+        /// calling randomReal once for each
+        /// \param low double - lower bound for range (inclusive)
+        /// \param high double - upper bound for range (exclusive)
+        /// \param double* values - array to fill
+        /// \param size_t count - number of values
+        void randomReals(double low, double high, double* values, size_t count);
+
+        /// \brief
+        ///
+        /// Fills an array with true false outcomes, the same outcomes as
+        /// calling randomChance once for each
+        /// \param double p - Value between 0 (never) and 1 (always)
+        /// \param bool* outcomes - array to fill
+        /// \param size_t count - number of outcomes
+        void randomChances(double p, bool* outcomes, size_t count);
+
+        /// \brief
+        ///
+        /// Generates the next 64 random bits, from which every other
+        /// method's numbers are made
+        /// \return uint64_t - random bits
+        uint64_t randomBits();
+
+        /// \brief
+        ///
+        /// Skips 2^128 numbers ahead, to a stream of numbers that
+        /// does not overlap the numbers before the jump
+        void jump();
+
     private:
 
+        // Instance variable storing the generator's state
+        uint64_t state[4];
+
         /// \brief
         ///
         /// Initializes the seed based on time to obtain different results
@@ -48,13 +127,29 @@ class Random {
 
         /// \brief
         ///
-        /// Helper method for randomChance
-        /// Generates a random real number greater than or equal to low and less than high
+        /// Initializes the state from a seed, spreading its bits with the
+        /// splitmix64 generator so similar seeds give unrelated numbers
+        /// \param uint64_t seed - any value
+        void seed(uint64_t seed);
+
+        /// \brief
         ///
-        /// \param low double - lower bound for range (inclusive)
-        /// \param high double - upper bound for range (exclusive)
-        /// \return double - A random real number between low and high
-        double randomReal(double low, double high);
+        /// Helper method for randomInteger and randomIntegers
+        /// Generates a random integer less than a bound without bias,
+        /// by multiplying random bits by it and rejecting the rare
+        /// products that would favour some results
+        /// \param uint64_t bound - number of possible results, at most 2^32
+        /// \return uint64_t - A random integer from 0 to bound - 1
+        uint64_t randomBelow(uint64_t bound);
+
+        /// \brief
+        ///
+        /// Helper method for randomChance and randomChances
+        /// Works out the number 53 random bits must be below for an outcome
+        /// to be true, so randomReal(0, 1) < p is decided without division
+        /// \param double p - Value between 0 (never) and 1 (always)
+        /// \return double - p scaled by 2^53
+        double chanceThreshold(double p);
 };
 
 #endif // _random_h
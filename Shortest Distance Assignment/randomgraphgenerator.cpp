@@ -0,0 +1,177 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: randomgraphgenerator.cpp
+/// Implementation of RandomGraphGenerator class
+/// Encapsulates a generator of random graphs joining each pair
+/// of cities with the same probability, in time linear in the edges
+
+#include <cmath>
+
+#include "randomgraphgenerator.h"
+#include "threadpool.h"
+
+// Constant defining the number of blocks the rows of pairs are split
+// into, fixed so the graph generated does not depend on the threads
+const unsigned int NUM_BLOCKS = 1024;
+
+/// Encapsulates a generator of G(n, p) graphs, in which every pair of
+/// cities i < j is joined with probability p, weighted by the distance
+/// between them. Rather than deciding every pair in turn, the method of
+/// Batagelj and Brandes draws the number of pairs skipped before the next
+/// edge from a geometric distribution, so the time taken grows with the
+/// number of edges made rather than the number of pairs. The rows of pairs
+/// are split into a fixed number of blocks generated by separate threads,
+/// each from its own stream of the seed, and the edges of the blocks are
+/// joined in order. Edges are listed as roads adds them, i then j
+/// increasing, and the same seed gives the same graph whatever the number
+/// of threads
+
+/// \brief
+///
+/// Constructor, initializes a generator that has generated nothing
+/// \param uint64_t seed - seed of the random numbers
+RandomGraphGenerator::RandomGraphGenerator(uint64_t seed){
+    this->seed = seed;
+}
+
+/// \brief
+///
+/// Destructor, no objects dynamically created from this class
+RandomGraphGenerator::~RandomGraphGenerator(){
+}
+
+/// \brief
+///
+/// Generates the edges of a random graph over a set of cities,
+/// replacing anything generated before
+/// \param PointSet* cities - co-ordinates of the cities
+/// \param double p - probability of joining each pair of cities
+/// \param unsigned int numThreads - number of threads, 0 for one
+/// per hardware thread
+/// \return bool - false if p is not between 0 and 1
+bool RandomGraphGenerator::generate(PointSet* cities, double p, unsigned int numThreads){
+
+    edges.clear();
+    if (!(p >= 0 && p <= 1)) return false;
+
+    unsigned int numVertices = cities->getSize();
+    if (p == 0 || numVertices < 2) return true;
+
+    std::vector<unsigned int> bounds;
+    split(numVertices, bounds);
+    unsigned int numBlocks = bounds.size() - 1;
+
+    // Every block takes the next stream of the seed, each 2^128 numbers
+    // on from the last, so no two blocks share any random numbers
+    std::vector<Random> streams;
+    streams.reserve(numBlocks);
+    Random random(seed);
+    for (unsigned int b = 0; b < numBlocks; b++) {
+        streams.push_back(random);
+        random.jump();
+    }
+
+    double logSkip = log1p(-p);
+    std::vector<std::vector<WeightedEdge> > found(numBlocks);
+    ThreadPool pool(numThreads);
+    pool.parallelFor(numBlocks, [&](unsigned int b, unsigned int) {
+        generateRows(cities, logSkip, bounds[b], bounds[b + 1], streams[b], found[b]);
+    });
+
+    size_t total = 0;
+    for (unsigned int b = 0; b < numBlocks; b++) {
+        total += found[b].size();
+    }
+    edges.reserve(total);
+    for (unsigned int b = 0; b < numBlocks; b++) {
+        edges.insert(edges.end(), found[b].begin(), found[b].end());
+    }
+    return true;
+}
+
+/// \brief
+///
+/// Simple getter for the edges generated
+/// \return const vector<WeightedEdge>& - edges
+const std::vector<WeightedEdge>& RandomGraphGenerator::getEdges(){
+    return edges;
+}
+
+/// \brief
+///
+/// Splits the rows of pairs into blocks holding about the same
+/// number of pairs, depending only on the number of cities
+/// \param unsigned int numVertices - number of cities
+/// \param vector<unsigned int>& bounds - filled with the first row of
+/// every block followed by the last row
+void RandomGraphGenerator::split(unsigned int numVertices, std::vector<unsigned int>& bounds){
+
+    // Row i holds the pairs (i, j) for every j > i, the last row holds none
+    unsigned int numRows = numVertices - 1;
+    unsigned long long numPairs = (unsigned long long) numVertices * (numVertices - 1) / 2;
+    unsigned int numBlocks = numRows < NUM_BLOCKS ? numRows : NUM_BLOCKS;
+
+    bounds.clear();
+    bounds.push_back(0);
+    unsigned long long pairs = 0;
+    for (unsigned int i = 0; i < numRows; i++) {
+        pairs += numVertices - 1 - i;
+        unsigned long long target = numPairs / numBlocks * bounds.size();
+        if (pairs >= target && bounds.size() < numBlocks && i + 1 < numRows) {
+            bounds.push_back(i + 1);
+        }
+    }
+    bounds.push_back(numRows);
+}
+
+/// \brief
+///
+/// Generates the edges of a block of rows, skipping a geometrically
+/// distributed number of pairs before each edge
+/// \param PointSet* cities - co-ordinates of the cities
+/// \param double logSkip - logarithm of the probability of skipping a pair
+/// \param unsigned int rowFirst - first row of the block
+/// \param unsigned int rowLast - one past the last row of the block
+/// \param Random& random - stream of random numbers of the block
+/// \param vector<WeightedEdge>& found - filled with the edges
+void RandomGraphGenerator::generateRows(PointSet* cities, double logSkip, unsigned int rowFirst,
+                                        unsigned int rowLast, Random& random,
+                                        std::vector<WeightedEdge>& found){
+
+    unsigned long long n = cities->getSize();
+    unsigned long long remaining = 0;
+    for (unsigned int i = rowFirst; i < rowLast; i++) {
+        remaining += n - 1 - i;
+    }
+
+    // j is the column of the last pair decided, i itself before the first
+    unsigned long long i = rowFirst;
+    unsigned long long j = rowFirst;
+    while (true) {
+
+        // The number of pairs skipped is geometrically distributed, the
+        // chance of skipping exactly k being (1 - p)^k p, and a skip past
+        // the end of the block ends it. A p of 1 never skips
+        double skip = floor(log(1 - random.randomReal(0, 1)) / logSkip);
+        if (!(skip < (double) remaining)) break;
+        unsigned long long skipped = (unsigned long long) skip;
+        remaining -= skipped + 1;
+
+        // Carry the column past the end of each row into the next,
+        // whose first column is one past its row
+        j += skipped + 1;
+        while (j >= n) {
+            j = j - n + i + 2;
+            i++;
+        }
+
+        WeightedEdge edge;
+        edge.source = i;
+        edge.destination = j;
+        found.push_back(edge);
+    }
+
+    // Edges come out row by row, so those of each row
+    // are weighed together once the block is done
+    cities->weighEdges(found.data(), found.size());
+}
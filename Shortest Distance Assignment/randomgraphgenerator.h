@@ -0,0 +1,91 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: randomgraphgenerator.h
+/// Header of RandomGraphGenerator class
+/// Encapsulates a generator of random graphs joining each pair
+/// of cities with the same probability, in time linear in the edges
+
+#ifndef _randomgraphgenerator_h
+#define _randomgraphgenerator_h
+
+#include <cstdint>
+#include <vector>
+
+#include "edge.h"
+#include "pointset.h"
+#include "random.h"
+
+/// Encapsulates a generator of G(n, p) graphs, in which every pair of
+/// cities i < j is joined with probability p, weighted by the distance
+/// between them. Rather than deciding every pair in turn, the method of
+/// Batagelj and Brandes draws the number of pairs skipped before the next
+/// edge from a geometric distribution, so the time taken grows with the
+/// number of edges made rather than the number of pairs. The rows of pairs
+/// are split into a fixed number of blocks generated by separate threads,
+/// each from its own stream of the seed, and the edges of the blocks are
+/// joined in order. Edges are listed as roads adds them, i then j
+/// increasing, and the same seed gives the same graph whatever the number
+/// of threads
+class RandomGraphGenerator {
+
+    public:
+
+        /// \brief
+        ///
+        /// Constructor, initializes a generator that has generated nothing
+        /// \param uint64_t seed - seed of the random numbers
+        RandomGraphGenerator(uint64_t seed);
+
+        /// \brief
+        ///
+        /// Destructor, no objects dynamically created from this class
+        ~RandomGraphGenerator();
+
+        /// \brief
+        ///
+        /// Generates the edges of a random graph over a set of cities,
+        /// replacing anything generated before
+        /// \param PointSet* cities - co-ordinates of the cities
+        /// \param double p - probability of joining each pair of cities
+        /// \param unsigned int numThreads - number of threads, 0 for one
+        /// per hardware thread
+        /// \return bool - false if p is not between 0 and 1
+        bool generate(PointSet* cities, double p, unsigned int numThreads);
+
+        /// \brief
+        ///
+        /// Simple getter for the edges generated
+        /// \return const vector<WeightedEdge>& - edges
+        const std::vector<WeightedEdge>& getEdges();
+
+    private:
+
+        // Instance variables storing the seed and the edges generated
+        uint64_t seed;
+        std::vector<WeightedEdge> edges;
+
+        /// \brief
+        ///
+        /// Splits the rows of pairs into blocks holding about the same
+        /// number of pairs, depending only on the number of cities
+        /// \param unsigned int numVertices - number of cities
+        /// \param vector<unsigned int>& bounds - filled with the first row of
+        /// every block followed by the last row
+        void split(unsigned int numVertices, std::vector<unsigned int>& bounds);
+
+        /// \brief
+        ///
+        /// Generates the edges of a block of rows, skipping a geometrically
+        /// distributed number of pairs before each edge
+        /// \param PointSet* cities - co-ordinates of the cities
+        /// \param double logSkip - logarithm of the probability of skipping a pair
+        /// \param unsigned int rowFirst - first row of the block
+        /// \param unsigned int rowLast - one past the last row of the block
+        /// \param Random& random - stream of random numbers of the block
+        /// \param vector<WeightedEdge>& found - filled with the edges
+        void generateRows(PointSet* cities, double logSkip, unsigned int rowFirst, unsigned int rowLast,
+                          Random& random, std::vector<WeightedEdge>& found);
+
+};
+
+#endif // _randomgraphgenerator_h
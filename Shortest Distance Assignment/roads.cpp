@@ -3,8 +3,11 @@
 /// Driver program for Shortest Distances.
 ///
 /// This program can use as input:
-/// 1.  Randomly generated points from the Cartesian plane
-/// 2.  Points from the Cartesian plane read from a file (file name given as a command line argument)
+/// 1.  Randomly generated points from the Cartesian plane, each pair joined at random, or with SKIP_PAIRS
+///     set joined by skipping from one edge to the next, see randomgraphgenerator.h
+/// 2.  Points from the Cartesian plane read from a file (file name given as a command line argument),
+///     either with a flag for every pair of points or with a line for every edge, see textgraphreader.h
+/// 3.  A binary graph file written by convert, which is mapped into memory and used in place
 ///
 /// The points are required to compute the edge weights between the vertices.
 ///
@@ -12,12 +15,14 @@
 ///
 
 #include <iostream>
-#include <fstream>
 #include <iomanip>
 
 #include "random.h"
 #include "point.h"
 #include "graph.h"
+#include "textgraphreader.h"
+#include "pointset.h"
+#include "randomgraphgenerator.h"
 
 using namespace std;
 
@@ -27,31 +32,51 @@ const int NUM_CITIES = 10;
 const int SOURCE = 0;
 const double EDGE_PROBABILITY = 0.45;
 
+// set to generate the random edges by skipping straight from one edge to the
+// next, which draws a different graph for a seed than trying every pair
+const bool SKIP_PAIRS = false;
+
 int main(int argc, char *argv[]) {
 
    bool readFromFile = (argc == 2);
    bool includeEdge;
-   ifstream infile;
+   TextGraphReader textFile;
+   GraphFile graphFile;
    int numCities = NUM_CITIES;
    Random* random = new Random();
    Point** cities;
 
+   // allow for testing from a binary graph file, which holds its edges
+   if (readFromFile && graphFile.open(argv[1])) {
+
+      // the co-ordinates are only needed for output, the graph uses the file's
+      numCities = graphFile.getNumVertices();
+      const double* coordinates = graphFile.getCoordinates();
+      cities = new Point*[numCities];
+      for (int city = 0; city < numCities; city++) {
+         if (coordinates != NULL) {
+            cities[city] = new Point(coordinates[2 * city], coordinates[2 * city + 1]);
+         } else {
+            cities[city] = new Point(0, 0);
+         }
+         cout << "City " << setw(2) << city << " co-ordinates : " << *cities[city] << endl;
+      }
+
    // allow for testing from file
-   if (readFromFile) {
-      // open the file and check it exists
-      infile.open(argv[1]);
-      if (infile.fail()) {
-         cerr <<  "Error: Could not find file" << endl;
+   } else if (readFromFile) {
+      // read the whole file and check it exists and is complete,
+      // the edges are parsed across one thread per hardware thread
+      if (!textFile.read(argv[1], 0)) {
+         cerr <<  "Error: Could not read file" << endl;
          return 1;
       }
 
-      // read the number of cities and their co-ordinates
-      int xCoordinate, yCoordinate;
-      infile >> numCities;
+      // store the cities at their co-ordinates
+      numCities = textFile.getNumVertices();
+      const vector<double>& coordinates = textFile.getCoordinates();
       cities = new Point*[numCities];
       for (int city = 0; city < numCities; city++) {
-         infile >> xCoordinate >> yCoordinate;
-         cities[city] = new Point(xCoordinate, yCoordinate);
+         cities[city] = new Point(coordinates[2 * city], coordinates[2 * city + 1]);
          cout << "City " << setw(2) << city << " co-ordinates : " << *cities[city] << endl;
       }
 
@@ -67,31 +92,50 @@ int main(int argc, char *argv[]) {
    }
    cout << endl;
 
-   // create the graph and add vertices for all cities
+   // create the graph with vertices for all cities, a binary
+   // graph file holds the co-ordinates of the cities itself
    Graph* graph = new Graph(numCities);
-   for (int i = 0; i < numCities; i++) {
-      Vertex* v = new Vertex(i);
-      graph->addVertex(v);
+   graph->reserveVertices(numCities);
+   if (!graphFile.isOpen()) {
+      for (int i = 0; i < numCities; i++) {
+         graph->setCoordinates(i, cities[i]);
+      }
    }
 
-   // add edges to graph
-   for (int i = 0; i < numCities - 1; i++) {
-      for (int j = i + 1; j < numCities; j++) {
-         if (readFromFile) {
-            infile >> includeEdge;
-         } else {
-            includeEdge = random->randomChance(EDGE_PROBABILITY);
-         }
-         if (includeEdge) {
-            Edge* edge = new Edge(graph->getVertex(i), graph->getVertex(j), cities[i]->distanceTo(cities[j]));
-            graph->addEdge(edge);
-         }
+   // add edges to graph, or use those in the binary graph file
+   if (graphFile.isOpen()) {
+      graph->useFile(graphFile);
+   } else if (readFromFile) {
+      const vector<WeightedEdge>& edges = textFile.getEdges();
+      graph->addEdges(edges.data(), edges.size());
+   } else {
+      PointSet points;
+      points.reserve(numCities);
+      for (int i = 0; i < numCities; i++) {
+         points.add(cities[i]);
       }
-   }
 
-   // if necessary close the input file
-   if (readFromFile) {
-      infile.close();
+      if (SKIP_PAIRS) {
+         // join each pair of cities with the edge probability, the generator
+         // skips straight from one edge to the next rather than trying every pair
+         RandomGraphGenerator generator(random->randomBits());
+         generator.generate(&points, EDGE_PROBABILITY, 0);
+         const vector<WeightedEdge>& edges = generator.getEdges();
+         graph->addEdges(edges.data(), edges.size());
+      } else {
+         // the distances from each city to the cities after it are
+         // calculated together, several at a time
+         vector<double> distances(numCities);
+         for (int i = 0; i < numCities - 1; i++) {
+            points.distancesFrom(i, i + 1, numCities, distances.data());
+            for (int j = i + 1; j < numCities; j++) {
+               includeEdge = random->randomChance(EDGE_PROBABILITY);
+               if (includeEdge) {
+                  graph->addEdge(i, j, distances[j - i - 1]);
+               }
+            }
+         }
+      }
    }
 
    cout << "Edge Weights" << endl;
@@ -0,0 +1,131 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: shortestpathtree.cpp
+/// Implementation of ShortestPathTree class
+/// Encapsulates the result of a search from a source vertex
+/// to every vertex, the distance and path to each
+
+#include <algorithm>
+
+#include "shortestpathtree.h"
+#include "graph.h"
+
+/// Encapsulates the result of a search from a source vertex to every vertex,
+/// the distance to each and the vertex preceding each on its path, which
+/// together form a tree rooted at the source. Paths are only walked when
+/// asked for, into a collection the caller can reuse, so searching does not
+/// pay for paths that are never looked at. A tree can be filled again by
+/// later searches, reusing its arrays and the queue the searches work with
+
+/// \brief
+///
+/// Constructor, initializes an empty tree
+ShortestPathTree::ShortestPathTree(){
+    source = 0;
+}
+
+/// \brief
+///
+/// Destructor, no objects dynamically created from this class
+ShortestPathTree::~ShortestPathTree(){
+}
+
+/// \brief
+///
+/// Simple getter for the source vertex the tree is rooted at
+/// \return unsigned int - source vertex's ID
+unsigned int ShortestPathTree::getSource(){
+    return source;
+}
+
+/// \brief
+///
+/// Simple getter for the number of vertices in the tree
+/// \return unsigned int - number of vertices
+unsigned int ShortestPathTree::getNumVertices(){
+    return distance.size();
+}
+
+/// \brief
+///
+/// Simple getter for the distance from the source to a vertex
+/// \param unsigned int - vertex's ID
+/// \return double - distance, INFINITY if the vertex cannot be reached
+double ShortestPathTree::getDistance(unsigned int v){
+    return distance[v];
+}
+
+/// \brief
+///
+/// Simple getter for the vertex preceding a vertex on its path
+/// \param unsigned int - vertex's ID
+/// \return unsigned int - preceding vertex's ID, the vertex itself for
+/// the source and for vertices that cannot be reached
+unsigned int ShortestPathTree::getPredecessorId(unsigned int v){
+    return predecessor[v];
+}
+
+/// \brief
+///
+/// Checks whether there is a path from the source to a vertex
+/// \param unsigned int - vertex's ID
+/// \return bool - true if reachable
+bool ShortestPathTree::isReachable(unsigned int v){
+    return v == source || predecessor[v] != v;
+}
+
+/// \brief
+///
+/// Simple getter for the distance from the source of every vertex
+/// \return const double* - pointer to the first distance
+const double* ShortestPathTree::getDistances(){
+    return distance.data();
+}
+
+/// \brief
+///
+/// Simple getter for the vertex preceding every vertex on its path
+/// \return const unsigned int* - pointer to the first predecessor
+const unsigned int* ShortestPathTree::getPredecessors(){
+    return predecessor.data();
+}
+
+/// \brief
+///
+/// Fills a collection with the path from the source to a vertex
+/// \param unsigned int v - vertex's ID
+/// \param vector<unsigned int>& path - filled with the vertex IDs from
+/// the source to the vertex, left empty if it cannot be reached
+void ShortestPathTree::pathTo(unsigned int v, std::vector<unsigned int>& path){
+
+    path.clear();
+    if (!isReachable(v)) return;
+
+    // Walk back to the source, then reverse in place
+    path.push_back(v);
+    while (v != source) {
+        v = predecessor[v];
+        path.push_back(v);
+    }
+    std::reverse(path.begin(), path.end());
+}
+
+/// \brief
+///
+/// Empties the tree ready for a search, leaving every vertex
+/// unreachable except the source at distance 0
+/// \param unsigned int N - number of vertices
+/// \param unsigned int source - source vertex's ID
+void ShortestPathTree::reset(unsigned int N, unsigned int source){
+
+    this->source = source;
+    distance.assign(N, INFINITY);
+    predecessor.resize(N);
+    for (unsigned int v = 0; v < N; v++) {
+        predecessor[v] = v;
+    }
+    distance[source] = 0;
+
+    queue.resize(N);
+    frontier.clear();
+}
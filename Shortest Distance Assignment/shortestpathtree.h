@@ -0,0 +1,112 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: shortestpathtree.h
+/// Header of ShortestPathTree class
+/// Encapsulates the result of a search from a source vertex
+/// to every vertex, the distance and path to each
+
+#ifndef _shortestpathtree_h
+#define _shortestpathtree_h
+
+#include <vector>
+
+#include "indexedheap.h"
+
+/// Encapsulates the result of a search from a source vertex to every vertex,
+/// the distance to each and the vertex preceding each on its path, which
+/// together form a tree rooted at the source. Paths are only walked when
+/// asked for, into a collection the caller can reuse, so searching does not
+/// pay for paths that are never looked at. A tree can be filled again by
+/// later searches, reusing its arrays and the queue the searches work with
+class ShortestPathTree {
+
+    public:
+
+        /// \brief
+        ///
+        /// Constructor, initializes an empty tree
+        ShortestPathTree();
+
+        /// \brief
+        ///
+        /// Destructor, no objects dynamically created from this class
+        ~ShortestPathTree();
+
+        /// \brief
+        ///
+        /// Simple getter for the source vertex the tree is rooted at
+        /// \return unsigned int - source vertex's ID
+        unsigned int getSource();
+
+        /// \brief
+        ///
+        /// Simple getter for the number of vertices in the tree
+        /// \return unsigned int - number of vertices
+        unsigned int getNumVertices();
+
+        /// \brief
+        ///
+        /// Simple getter for the distance from the source to a vertex
+        /// \param unsigned int - vertex's ID
+        /// \return double - distance, INFINITY if the vertex cannot be reached
+        double getDistance(unsigned int);
+
+        /// \brief
+        ///
+        /// Simple getter for the vertex preceding a vertex on its path
+        /// \param unsigned int - vertex's ID
+        /// \return unsigned int - preceding vertex's ID, the vertex itself for
+        /// the source and for vertices that cannot be reached
+        unsigned int getPredecessorId(unsigned int);
+
+        /// \brief
+        ///
+        /// Checks whether there is a path from the source to a vertex
+        /// \param unsigned int - vertex's ID
+        /// \return bool - true if reachable
+        bool isReachable(unsigned int);
+
+        /// \brief
+        ///
+        /// Simple getter for the distance from the source of every vertex
+        /// \return const double* - pointer to the first distance
+        const double* getDistances();
+
+        /// \brief
+        ///
+        /// Simple getter for the vertex preceding every vertex on its path
+        /// \return const unsigned int* - pointer to the first predecessor
+        const unsigned int* getPredecessors();
+
+        /// \brief
+        ///
+        /// Fills a collection with the path from the source to a vertex
+        /// \param unsigned int v - vertex's ID
+        /// \param vector<unsigned int>& path - filled with the vertex IDs from
+        /// the source to the vertex, left empty if it cannot be reached
+        void pathTo(unsigned int v, std::vector<unsigned int>& path);
+
+    private:
+
+        friend class Graph;
+
+        // Instance variables storing the source vertex, the distance and
+        // predecessor of every vertex, and the queue and frontier the
+        // searches filling the tree work with
+        unsigned int source;
+        std::vector<double> distance;
+        std::vector<unsigned int> predecessor;
+        IndexedHeap queue;
+        std::vector<unsigned int> frontier;
+
+        /// \brief
+        ///
+        /// Empties the tree ready for a search, leaving every vertex
+        /// unreachable except the source at distance 0
+        /// \param unsigned int N - number of vertices
+        /// \param unsigned int source - source vertex's ID
+        void reset(unsigned int N, unsigned int source);
+
+};
+
+#endif // _shortestpathtree_h
@@ -0,0 +1,483 @@
+/// File:  tests.cpp
+///
+/// Driver program running regression tests of Shortest Distances.
+///
+/// Each test builds its input in code, checks the result against a slower
+/// calculation known to be right and reports PASS or FAIL. The program
+/// fails if any test fails.
+///
+/// Usage: tests
+///
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+
+#include "graph.h"
+#include "point.h"
+#include "delaunay.h"
+#include "disjointset.h"
+#include "random.h"
+#include "textgraphreader.h"
+#include "shortestpathtree.h"
+#include "graphstats.h"
+#include "compressedsparserow.h"
+#include "graphfile.h"
+#include "contractionhierarchy.h"
+
+using namespace std;
+
+const double PI = 3.14159265358979323846;
+const char* GRAPH_FILE = "tests_graph.txt";
+
+// Counts the components of the graph formed by a list of edges
+unsigned int countComponents(unsigned int numPoints, const vector<WeightedEdge>& edges) {
+   DisjointSet components(numPoints);
+   unsigned int count = numPoints;
+   for (const WeightedEdge& e : edges) {
+      if (!components.sameComponent(e.source, e.destination)) {
+         components.join(e.source, e.destination);
+         count--;
+      }
+   }
+   return count;
+}
+
+// Checks the Delaunay triangulation of points is connected and the Euclidean
+// minimum spanning tree found through it spans every point, at the cost given
+// or, if none is given, the cost of Kruskal's algorithm over every pair
+bool checkEuclideanTree(const vector<double>& xy, double expected = -1) {
+
+   unsigned int numPoints = xy.size() / 2;
+   vector<WeightedEdge> triangulation;
+   Delaunay delaunay;
+   delaunay.triangulate(xy.data(), numPoints, triangulation);
+   if (countComponents(numPoints, triangulation) != 1) return false;
+
+   Graph euclidean(numPoints);
+   euclidean.reserveVertices(numPoints);
+   for (unsigned int i = 0; i < numPoints; i++) {
+      Point p(xy[2 * i], xy[2 * i + 1]);
+      euclidean.setCoordinates(i, &p);
+   }
+   double cost = euclidean.minimumSpanningTreeCost(EUCLIDEAN, 1);
+   vector<WeightedEdge> tree;
+   euclidean.getSpanningTreeEdges(tree);
+   if (tree.size() + 1 != numPoints) return false;
+
+   if (expected < 0) {
+      Graph complete(numPoints);
+      complete.reserveVertices(numPoints);
+      for (unsigned int i = 0; i < numPoints; i++) {
+         Point p(xy[2 * i], xy[2 * i + 1]);
+         for (unsigned int j = 0; j < i; j++) {
+            Point q(xy[2 * j], xy[2 * j + 1]);
+            complete.addEdge(j, i, p.distanceTo(&q));
+         }
+      }
+      expected = complete.minimumSpanningTreeCost();
+   }
+   return fabs(cost - expected) <= 1e-9 * expected;
+}
+
+// Points on a circle at the given angles in degrees, nearly
+// cocircular once their coordinates are rounded
+bool testCocircularPoints() {
+   const double degrees[] = { 27, 130, 192, 103 };
+   vector<double> xy;
+   for (double d : degrees) {
+      xy.push_back(50 + 10 * cos(d * PI / 180));
+      xy.push_back(50 + 10 * sin(d * PI / 180));
+   }
+   if (!checkEuclideanTree(xy)) return false;
+
+   Random random(1);
+   for (int set = 0; set < 500; set++) {
+      unsigned int numPoints = random.randomInteger(4, 12);
+      double radius = random.randomReal(0.1, 100);
+      xy.clear();
+      for (unsigned int i = 0; i < numPoints; i++) {
+         double angle = random.randomReal(0, 2 * PI);
+         xy.push_back(50 + radius * cos(angle));
+         xy.push_back(50 + radius * sin(angle));
+      }
+      if (!checkEuclideanTree(xy)) return false;
+   }
+   return true;
+}
+
+// Square lattices with steps that are not exact in binary, every square
+// of four points nearly cocircular, the larger too large for every pair
+// to be joined but spanned by edges of about one step each
+bool testScaledLattice() {
+   const unsigned int sides[] = { 20, 100 };
+   const double steps[] = { 0.1, 0.3 };
+   for (unsigned int side : sides) {
+      for (double step : steps) {
+         vector<double> xy;
+         for (unsigned int i = 0; i < side; i++) {
+            for (unsigned int j = 0; j < side; j++) {
+               xy.push_back(i * step);
+               xy.push_back(j * step);
+            }
+         }
+         double expected = side > 20 ? (side * side - 1) * step : -1;
+         if (!checkEuclideanTree(xy, expected)) return false;
+      }
+   }
+   return true;
+}
+
+// Random graphs with real weights, on which every minimum spanning
+// tree algorithm must return the same cost to the last bit
+bool testSpanningTreeCosts() {
+   Random random(2);
+   for (int graph = 0; graph < 50; graph++) {
+      unsigned int numVertices = random.randomInteger(2, 2000);
+      unsigned int numEdges = random.randomInteger(1, 8 * numVertices);
+      Graph g(numVertices);
+      g.reserveVertices(numVertices);
+      for (unsigned int e = 0; e < numEdges; e++) {
+         g.addEdge(random.randomInteger(0, numVertices - 1), random.randomInteger(0, numVertices - 1),
+                   random.randomReal(0, 100));
+      }
+      double kruskal = g.minimumSpanningTreeCost(KRUSKAL, 1);
+      if (g.minimumSpanningTreeCost(FILTER_KRUSKAL, 1) != kruskal) return false;
+      if (g.minimumSpanningTreeCost(BORUVKA, 0) != kruskal) return false;
+      if (g.getSpanningTreeCost() != kruskal) return false;
+   }
+   return true;
+}
+
+// Random edges added in batches to a graph whose minimum spanning tree was
+// calculated, the tree kept up to date matching Kruskal's algorithm rerun,
+// while a Euclidean tree, over edges not in the list, is left as it was
+bool testIncrementalSpanningTree() {
+   Random random(3);
+   unsigned int numVertices = 500;
+   Graph g(numVertices);
+   g.reserveVertices(numVertices);
+   Graph euclidean(numVertices);
+   euclidean.reserveVertices(numVertices);
+   for (unsigned int v = 0; v < numVertices; v++) {
+      Point p(random.randomReal(0, 100), random.randomReal(0, 100));
+      euclidean.setCoordinates(v, &p);
+   }
+   double euclideanCost = euclidean.minimumSpanningTreeCost(EUCLIDEAN, 1);
+   g.minimumSpanningTreeCost(KRUSKAL, 1);
+
+   vector<WeightedEdge> all;
+   for (int batch = 0; batch < 20; batch++) {
+      vector<WeightedEdge> added(100);
+      for (WeightedEdge& e : added) {
+         e.source = random.randomInteger(0, numVertices - 1);
+         e.destination = random.randomInteger(0, numVertices - 1);
+         e.weight = random.randomInteger(1, 20);
+      }
+      all.insert(all.end(), added.begin(), added.end());
+      g.addEdges(added.data(), added.size());
+      euclidean.addEdges(added.data(), added.size());
+
+      Graph rerun(numVertices);
+      rerun.reserveVertices(numVertices);
+      rerun.addEdges(all.data(), all.size());
+      double cost = rerun.minimumSpanningTreeCost();
+      vector<WeightedEdge> kept, rerunTree;
+      g.getSpanningTreeEdges(kept);
+      rerun.getSpanningTreeEdges(rerunTree);
+      if (g.getSpanningTreeCost() != cost || kept.size() != rerunTree.size()) return false;
+      if (euclidean.getSpanningTreeCost() != euclideanCost) return false;
+   }
+   return true;
+}
+
+// Five points along a line ten apart joined only end to end, so breadth first
+// search along their Euclidean tree crosses edges missing from the edge list
+bool testEuclideanTreeSearch() {
+   Graph g(5);
+   g.reserveVertices(5);
+   for (unsigned int v = 0; v < 5; v++) {
+      Point p(10.0 * v, 0);
+      g.setCoordinates(v, &p);
+   }
+   g.addEdge(0, 4, 40);
+   if (g.minimumSpanningTreeCost(EUCLIDEAN, 1) != 40) return false;
+
+   ShortestPathTree tree;
+   g.breadthFirstPaths(0, tree);
+   for (unsigned int v = 0; v < 5; v++) {
+      if (tree.getDistance(v) != 10.0 * v) return false;
+   }
+   return true;
+}
+
+// Random edges added and made lighter in batches on a graph whose shortest
+// paths from one source and minimum spanning tree are kept up to date, each
+// lowered in place, both matching a graph built again from the same edges
+bool testMaintainedShortestPaths() {
+   Random random(5);
+   unsigned int numVertices = 1000;
+   vector<WeightedEdge> all;
+   Graph g(numVertices);
+   g.reserveVertices(numVertices);
+   for (unsigned int e = 0; e < 2 * numVertices; e++) {
+      WeightedEdge added;
+      added.source = random.randomInteger(0, numVertices - 1);
+      added.destination = random.randomInteger(0, numVertices - 1);
+      added.weight = random.randomInteger(50, 100);
+      all.push_back(added);
+   }
+   g.addEdges(all.data(), all.size());
+   g.minimumSpanningTreeCost(KRUSKAL, 1);
+   g.maintainShortestPaths(0);
+
+   for (int batch = 0; batch < 20; batch++) {
+      vector<WeightedEdge> added(50);
+      for (WeightedEdge& e : added) {
+         e.source = random.randomInteger(0, numVertices - 1);
+         e.destination = random.randomInteger(0, numVertices - 1);
+         e.weight = random.randomInteger(50, 100);
+      }
+      all.insert(all.end(), added.begin(), added.end());
+      g.addEdges(added.data(), added.size());
+
+      // Only the lightest edge between the end points is lowered, and
+      // only when the new weight is lower, the others left as they were
+      for (int change = 0; change < 50; change++) {
+         const WeightedEdge& picked = all[random.randomInteger(0, all.size() - 1)];
+         unsigned int u = picked.source;
+         unsigned int v = picked.destination;
+         double weight = random.randomInteger(1, 100);
+         unsigned int lightest = all.size();
+         for (unsigned int e = 0; e < all.size(); e++) {
+            bool joins = (all[e].source == u && all[e].destination == v)
+                         || (all[e].source == v && all[e].destination == u);
+            if (joins && (lightest == all.size() || all[e].weight < all[lightest].weight)) lightest = e;
+         }
+         bool lower = weight < all[lightest].weight;
+         if (g.decreaseWeight(u, v, weight) != lower) return false;
+         if (lower) all[lightest].weight = weight;
+      }
+
+      Graph rerun(numVertices);
+      rerun.reserveVertices(numVertices);
+      rerun.addEdges(all.data(), all.size());
+      ShortestPathTree expected;
+      rerun.shortestPaths(0, expected);
+      if (g.getSpanningTreeCost() != rerun.minimumSpanningTreeCost()) return false;
+
+      // Every distance matches, and every predecessor is joined to its
+      // vertex by an edge covering the difference in their distances
+      CompressedSparseRow adjacency;
+      adjacency.build(numVertices, all.data(), all.size());
+      ShortestPathTree& kept = g.getMaintainedPaths();
+      for (unsigned int v = 0; v < numVertices; v++) {
+         if (kept.getDistance(v) != expected.getDistance(v)) return false;
+         unsigned int u = kept.getPredecessorId(v);
+         if (v == 0 || !kept.isReachable(v)) continue;
+         if (kept.getDistance(u) + adjacency.weightBetween(u, v, 1e300) != kept.getDistance(v)) return false;
+      }
+   }
+   return true;
+}
+
+// Whether two distances found by summing weights in different orders agree
+bool isClose(double a, double b) {
+   return fabs(a - b) <= 1e-9 * (b > 1 ? b : 1);
+}
+
+// Checks a path found between two vertices runs from one to the other along
+// edges whose weights sum to its distance, or is empty if there is no path
+bool isPath(const vector<unsigned int>& path, unsigned int source, unsigned int target, double distance,
+            CompressedSparseRow& adjacency) {
+   if (distance == INFINITY) return path.empty();
+   if (path.empty() || path.front() != source || path.back() != target) return false;
+   double sum = 0;
+   for (unsigned int i = 1; i < path.size(); i++) {
+      sum += adjacency.weightBetween(path[i - 1], path[i], INFINITY);
+   }
+   return isClose(sum, distance);
+}
+
+// Random points joined by edges at least as long as the straight line
+// between them, some left unreachable, on which every point to point search
+// and delta-stepping must find the distances Dijkstra's algorithm finds
+bool testSearchesAgree() {
+   Random random(6);
+   unsigned int numVertices = 300;
+   Graph g(numVertices);
+   g.reserveVertices(numVertices);
+   vector<Point> points;
+   for (unsigned int v = 0; v < numVertices; v++) {
+      points.push_back(Point(random.randomReal(0, 100), random.randomReal(0, 100)));
+      g.setCoordinates(v, &points[v]);
+   }
+   for (unsigned int e = 0; e < 3 * numVertices; e++) {
+      unsigned int u = random.randomInteger(0, numVertices - 1);
+      unsigned int v = random.randomInteger(0, numVertices - 1);
+      g.addEdge(u, v, points[u].distanceTo(&points[v]) * random.randomReal(1, 2));
+   }
+
+   ContractionHierarchy hierarchy;
+   hierarchy.build(g, 2);
+   CompressedSparseRow& adjacency = g.getAdjacency();
+
+   for (int query = 0; query < 50; query++) {
+      unsigned int source = random.randomInteger(0, numVertices - 1);
+      ShortestPathTree dijkstra, deltaStepping;
+      g.shortestPaths(source, dijkstra);
+      g.deltaSteppingShortestPaths(source, deltaStepping, 0, 2);
+
+      for (unsigned int v = 0; v < numVertices; v++) {
+         if (deltaStepping.getDistance(v) != dijkstra.getDistance(v)) return false;
+      }
+
+      for (int pair = 0; pair < 20; pair++) {
+         unsigned int target = random.randomInteger(0, numVertices - 1);
+         double expected = dijkstra.getDistance(target);
+         vector<unsigned int> path;
+
+         double distance = hierarchy.query(source, target, path);
+         if (!isClose(distance, expected) || !isPath(path, source, target, distance, adjacency)) return false;
+         distance = g.bidirectionalShortestPath(source, target, path);
+         if (!isClose(distance, expected) || !isPath(path, source, target, distance, adjacency)) return false;
+         distance = g.aStar(source, target, path);
+         if (!isClose(distance, expected) || !isPath(path, source, target, distance, adjacency)) return false;
+      }
+   }
+   return true;
+}
+
+// Writes a graph text file and reads it back
+bool readsText(const string& text, unsigned int numThreads) {
+   ofstream out(GRAPH_FILE);
+   out << text;
+   out.close();
+   TextGraphReader reader;
+   bool valid = reader.read(GRAPH_FILE, numThreads);
+   remove(GRAPH_FILE);
+   return valid;
+}
+
+// Dense graph files of three cities, their three flags only
+// accepted when nothing is missing and nothing follows them
+bool testTrailingFlags() {
+   const string cities = "3\n0 0\n3 0\n0 4\n";
+   for (unsigned int numThreads = 1; numThreads <= 4; numThreads += 3) {
+      if (!readsText(cities + "1 1 0\n", numThreads)) return false;
+      if (readsText(cities + "1 1\n", numThreads)) return false;
+      if (readsText(cities + "1 1 0 1\n", numThreads)) return false;
+      if (readsText(cities + "1 1 0 7 junk\n", numThreads)) return false;
+   }
+   return true;
+}
+
+// Writes a graph file of three vertices and two edges, overwrites an
+// identifier at a byte position in one of its sections, unless the
+// section is NULL, and reports whether the file still opens
+bool opensWith(unsigned long long GraphFileHeader::* section, unsigned int position, unsigned int id) {
+   vector<WeightedEdge> edges(2);
+   edges[0].source = 0;
+   edges[0].destination = 1;
+   edges[0].weight = 3;
+   edges[1].source = 1;
+   edges[1].destination = 2;
+   edges[1].weight = 4;
+   if (!GraphFile::write(GRAPH_FILE, 3, NULL, edges)) return false;
+
+   if (section != NULL) {
+      fstream file(GRAPH_FILE, ios::in | ios::out | ios::binary);
+      GraphFileHeader header;
+      file.read((char*) &header, sizeof(header));
+      file.seekp(header.*section + position);
+      file.write((const char*) &id, sizeof(id));
+   }
+
+   GraphFile graphFile;
+   bool opened = graphFile.open(GRAPH_FILE);
+   graphFile.close();
+   remove(GRAPH_FILE);
+   return opened;
+}
+
+// Graph files whose row offsets decrease or whose neighbours or edge
+// end points are not vertices, all refused when opened
+bool testGraphFileIds() {
+   return opensWith(NULL, 0, 0)
+          && !opensWith(&GraphFileHeader::offsetsOffset, sizeof(unsigned int), 4)
+          && !opensWith(&GraphFileHeader::targetsOffset, 0, 3)
+          && !opensWith(&GraphFileHeader::edgesOffset, 0, 7)
+          && !opensWith(&GraphFileHeader::edgesOffset, sizeof(unsigned int), 3);
+}
+
+// Whether every counter of a set of statistics is zero
+bool isZero(const GraphStats& stats) {
+   return stats.relaxations == 0 && stats.heapPushes == 0 && stats.heapDecreases == 0
+          && stats.heapPops == 0 && stats.verticesSettled == 0 && stats.finds == 0
+          && stats.findPathLength == 0 && stats.compressionWrites == 0
+          && stats.edgesScanned == 0 && stats.edgesRejected == 0;
+}
+
+// Every search from one source settles each reachable vertex once and,
+// but for delta-stepping's split of light and heavy edges, relaxes the same
+// edges, so each is counted alike when counting is compiled in, and
+// nothing is counted when it is not
+bool testSearchStats() {
+   Random random(4);
+   unsigned int numVertices = 2000;
+   Graph g(numVertices);
+   g.reserveVertices(numVertices);
+   for (unsigned int e = 0; e < 4 * numVertices; e++) {
+      g.addEdge(random.randomInteger(0, numVertices - 1), random.randomInteger(0, numVertices - 1),
+                random.randomReal(0, 100));
+   }
+
+   ShortestPathTree tree;
+   Graph::resetStats();
+   g.shortestPaths(0, tree);
+   GraphStats dijkstra = Graph::getStats();
+
+   vector<double> distances;
+   Graph::resetStats();
+   g.multiSourceShortestPaths(vector<unsigned int>(1, 0), 2, distances, NULL);
+   GraphStats multiSource = Graph::getStats();
+
+   ShortestPathTree deltaTree;
+   Graph::resetStats();
+   g.deltaSteppingShortestPaths(0, deltaTree, 0, 2);
+   GraphStats deltaStepping = Graph::getStats();
+
+   if (!StatsRecorder::isEnabled()) {
+      return isZero(dijkstra) && isZero(multiSource) && isZero(deltaStepping);
+   }
+   return dijkstra.verticesSettled > 0
+          && multiSource.verticesSettled == dijkstra.verticesSettled
+          && multiSource.relaxations == dijkstra.relaxations
+          && deltaStepping.verticesSettled >= dijkstra.verticesSettled
+          && deltaStepping.relaxations >= dijkstra.relaxations;
+}
+
+// Runs a test and reports the result
+bool run(const char* name, bool (*test)()) {
+   bool passed = test();
+   cout << (passed ? "PASS " : "FAIL ") << name << endl;
+   return passed;
+}
+
+int main() {
+   bool passed = true;
+   passed = run("cocircular points", testCocircularPoints) && passed;
+   passed = run("scaled lattice", testScaledLattice) && passed;
+   passed = run("spanning tree costs", testSpanningTreeCosts) && passed;
+   passed = run("incremental spanning tree", testIncrementalSpanningTree) && passed;
+   passed = run("euclidean tree search", testEuclideanTreeSearch) && passed;
+   passed = run("maintained shortest paths", testMaintainedShortestPaths) && passed;
+   passed = run("searches agree", testSearchesAgree) && passed;
+   passed = run("trailing flags", testTrailingFlags) && passed;
+   passed = run("graph file identifiers", testGraphFileIds) && passed;
+   passed = run("search stats", testSearchStats) && passed;
+   return passed ? 0 : 1;
+}
@@ -0,0 +1,393 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: textgraphreader.cpp
+/// Implementation of TextGraphReader class
+/// Encapsulates a reader of graph text files that maps the
+/// whole file and parses its numbers across threads
+
+#include <charconv>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "textgraphreader.h"
+#include "threadpool.h"
+#include "pointset.h"
+
+// Constant defining the number of characters in each block of
+// the edge section, each block is one task of the thread pool
+const size_t BLOCK_SIZE = 1 << 20;
+
+/// Encapsulates a reader of the two graph text formats. Both start with
+/// the number of cities followed by the co-ordinates of every city. In the
+/// dense format read by roads the first line holds only the number of cities,
+/// and the co-ordinates are followed by one 0 or 1 flag for every pair of
+/// cities i < j saying whether they are joined. In the sparse format the
+/// first line also holds the number of edges, and the co-ordinates are
+/// followed by one line per edge holding the IDs of its end points and
+/// optionally its weight. Edges without a weight are weighted by the
+/// distance between their end points, as roads weights them.
+/// The file is mapped rather than read through a stream, numbers are parsed
+/// with std::from_chars, which consults no locale, and flags are checked
+/// character by character. The edge section
+/// is split into blocks parsed by separate threads, and the edges of the
+/// blocks are joined in file order so they are listed as roads adds them
+
+/// \brief
+///
+/// Constructor, initializes a reader that has read nothing
+TextGraphReader::TextGraphReader(){
+    sparse = false;
+    numVertices = 0;
+}
+
+/// \brief
+///
+/// Destructor, no objects dynamically created from this class
+TextGraphReader::~TextGraphReader(){
+}
+
+/// \brief
+///
+/// Reads a graph text file in either format, replacing
+/// anything read before
+/// \param const char* fileName - name of the file
+/// \param unsigned int numThreads - number of threads parsing the edges,
+/// 0 for one per hardware thread
+/// \return bool - true if the file was found and every number in it
+/// read, false if it is missing, cut short or holds anything else
+bool TextGraphReader::read(const char* fileName, unsigned int numThreads){
+
+    sparse = false;
+    numVertices = 0;
+    coordinates.clear();
+    edges.clear();
+
+    int fd = ::open(fileName, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // The mapping keeps the file alive, so the descriptor is not needed after
+    void* mapped = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+
+    const char* text = (const char*) mapped;
+    bool valid = parse(text, text + status.st_size, numThreads);
+    munmap(mapped, status.st_size);
+
+    if (!valid) {
+        numVertices = 0;
+        coordinates.clear();
+        edges.clear();
+    }
+    return valid;
+}
+
+/// \brief
+///
+/// Simple getter for whether the file read was in the sparse format
+/// \return bool - true if sparse
+bool TextGraphReader::isSparse(){
+    return sparse;
+}
+
+/// \brief
+///
+/// Simple getter for the number of cities read
+/// \return unsigned int - number of vertices
+unsigned int TextGraphReader::getNumVertices(){
+    return numVertices;
+}
+
+/// \brief
+///
+/// Simple getter for the co-ordinates read, x and y of every city in pairs
+/// \return const vector<double>& - co-ordinates
+const std::vector<double>& TextGraphReader::getCoordinates(){
+    return coordinates;
+}
+
+/// \brief
+///
+/// Simple getter for the edges read, in the order they appear in the file
+/// \return const vector<WeightedEdge>& - edges
+const std::vector<WeightedEdge>& TextGraphReader::getEdges(){
+    return edges;
+}
+
+/// \brief
+///
+/// Parses the text of a graph file in either format
+/// \param const char* text - first character
+/// \param const char* end - one past the last character
+/// \param unsigned int numThreads - number of threads parsing the edges
+/// \return bool - true if every number was read
+bool TextGraphReader::parse(const char* text, const char* end, unsigned int numThreads){
+
+    unsigned long long N;
+    if (!readNumber(text, end, N) || N > 0xFFFFFFFF) return false;
+
+    // A second number on the first line is the number of edges of the sparse format
+    unsigned long long M = 0;
+    sparse = !atLineEnd(text, end);
+    if (sparse && !readNumber(text, end, M)) return false;
+
+    numVertices = N;
+    coordinates.resize(2 * N);
+    for (unsigned long long i = 0; i < 2 * N; i++) {
+        if (!readNumber(text, end, coordinates[i])) return false;
+    }
+
+    if (sparse) {
+        return parseEdgeLines(text, end, M, numThreads);
+    }
+    return parseFlags(text, end, numThreads);
+}
+
+/// \brief
+///
+/// Parses the edge flags of the dense format, each block of the text
+/// counting its flags first so it knows which pair its first flag is for
+/// \param const char* text - first character of the flags
+/// \param const char* end - one past the last character
+/// \param unsigned int numThreads - number of threads
+/// \return bool - true if every pair has a flag of 0 or 1 and nothing follows
+bool TextGraphReader::parseFlags(const char* text, const char* end, unsigned int numThreads){
+
+    unsigned long long numPairs = numVertices < 2 ? 0 : (unsigned long long) numVertices * (numVertices - 1) / 2;
+
+    std::vector<const char*> bounds;
+    split(text, end, false, bounds);
+    unsigned int numBlocks = bounds.size() - 1;
+
+    std::vector<unsigned long long> first(numBlocks + 1, 0);
+    std::vector<std::vector<WeightedEdge> > found(numBlocks);
+    std::vector<char> failed(numBlocks, 0);
+    ThreadPool pool(numThreads);
+
+    // Count the flags of every block, the running total of the
+    // counts is then the index of the first flag of each block
+    pool.parallelFor(numBlocks, [&](unsigned int b, unsigned int) {
+        unsigned long long count = 0;
+        bool inFlag = false;
+        for (const char* p = bounds[b]; p < bounds[b + 1]; p++) {
+            bool space = isSpace(*p);
+            count += !space && !inFlag;
+            inFlag = !space;
+        }
+        first[b + 1] = count;
+    });
+
+    for (unsigned int b = 0; b < numBlocks; b++) {
+        first[b + 1] += first[b];
+    }
+    // A flag for every pair and nothing after, such as stray tokens
+    if (first[numBlocks] != numPairs) return false;
+
+    pool.parallelFor(numBlocks, [&](unsigned int b, unsigned int) {
+        unsigned long long k = first[b];
+        unsigned long long last = first[b + 1] < numPairs ? first[b + 1] : numPairs;
+        if (k >= last) return;
+
+        // Row i holds the pairs (i, j) for every j > i, so walk
+        // the rows to find the pair of the block's first flag
+        unsigned int i = 0;
+        unsigned long long rest = k;
+        while (rest >= numVertices - 1 - i) {
+            rest -= numVertices - 1 - i;
+            i++;
+        }
+        unsigned int j = i + 1 + rest;
+
+        // Flags are single digits, so they are checked directly rather than
+        // parsed, a block boundary always follows white space or ends the text
+        const char* p = bounds[b];
+        const char* stop = bounds[b + 1];
+        while (k < last) {
+            while (p < stop && isSpace(*p)) {
+                p++;
+            }
+            if (p == stop || (*p != '0' && *p != '1') || (p + 1 < stop && !isSpace(p[1]))) break;
+
+            if (*p++ == '1') {
+                WeightedEdge edge;
+                edge.source = i;
+                edge.destination = j;
+                edge.weight = distanceBetween(i, j);
+                found[b].push_back(edge);
+            }
+            k++;
+            if (++j == numVertices) {
+                i++;
+                j = i + 1;
+            }
+        }
+        failed[b] = k < last;
+    });
+
+    for (unsigned int b = 0; b < numBlocks; b++) {
+        if (failed[b]) return false;
+    }
+    for (unsigned int b = 0; b < numBlocks; b++) {
+        edges.insert(edges.end(), found[b].begin(), found[b].end());
+    }
+    return true;
+}
+
+/// \brief
+///
+/// Parses the edge lines of the sparse format, in blocks of whole lines
+/// \param const char* text - first character of the edge lines
+/// \param const char* end - one past the last character
+/// \param unsigned long long numEdges - number of edges in the file
+/// \param unsigned int numThreads - number of threads
+/// \return bool - true if every line names two cities and
+/// there are as many lines as edges
+bool TextGraphReader::parseEdgeLines(const char* text, const char* end, unsigned long long numEdges,
+                                     unsigned int numThreads){
+
+    std::vector<const char*> bounds;
+    split(text, end, true, bounds);
+    unsigned int numBlocks = bounds.size() - 1;
+
+    std::vector<std::vector<WeightedEdge> > found(numBlocks);
+    std::vector<char> failed(numBlocks, 0);
+    ThreadPool pool(numThreads);
+
+    pool.parallelFor(numBlocks, [&](unsigned int b, unsigned int) {
+        const char* p = bounds[b];
+        const char* stop = bounds[b + 1];
+        unsigned long long u, v;
+
+        // Every line holds two IDs and perhaps a weight, and nothing else
+        while (readNumber(p, stop, u)) {
+            WeightedEdge edge;
+            if (atLineEnd(p, stop) || !readNumber(p, stop, v) || u >= numVertices || v >= numVertices) {
+                failed[b] = 1;
+                return;
+            }
+            edge.source = u;
+            edge.destination = v;
+            if (atLineEnd(p, stop)) {
+                edge.weight = distanceBetween(u, v);
+            } else if (!readNumber(p, stop, edge.weight) || !atLineEnd(p, stop)) {
+                failed[b] = 1;
+                return;
+            }
+            found[b].push_back(edge);
+        }
+        failed[b] = p != stop;
+    });
+
+    unsigned long long total = 0;
+    for (unsigned int b = 0; b < numBlocks; b++) {
+        if (failed[b]) return false;
+        total += found[b].size();
+    }
+    if (total != numEdges) return false;
+
+    edges.reserve(total);
+    for (unsigned int b = 0; b < numBlocks; b++) {
+        edges.insert(edges.end(), found[b].begin(), found[b].end());
+    }
+    return true;
+}
+
+/// \brief
+///
+/// Splits text into blocks of about the same size, moving each
+/// boundary forward past the next separator character
+/// \param const char* text - first character
+/// \param const char* end - one past the last character
+/// \param bool lines - true to split at line breaks, false at any white space
+/// \param vector<const char*>& bounds - filled with the first character of
+/// every block followed by end
+void TextGraphReader::split(const char* text, const char* end, bool lines, std::vector<const char*>& bounds){
+
+    size_t numBlocks = (end - text) / BLOCK_SIZE + 1;
+    bounds.clear();
+    bounds.push_back(text);
+
+    // A number or line longer than a block can carry a boundary past
+    // the next one, which then starts where it does and is left empty
+    for (size_t b = 1; b < numBlocks; b++) {
+        const char* p = text + b * BLOCK_SIZE;
+        if (p < bounds.back()) p = bounds.back();
+        while (p < end && !(lines ? *p == '\n' : isSpace(*p))) {
+            p++;
+        }
+        if (p < end) p++;
+        bounds.push_back(p);
+    }
+    bounds.push_back(end);
+}
+
+/// \brief
+///
+/// Straight line distance between two cities, calculated
+/// exactly as Point::distanceTo calculates it
+/// \param unsigned int u - first city
+/// \param unsigned int v - second city
+/// \return double - distance
+double TextGraphReader::distanceBetween(unsigned int u, unsigned int v){
+    return PointSet::distance(coordinates[2 * u], coordinates[2 * u + 1], coordinates[2 * v], coordinates[2 * v + 1]);
+}
+
+/// \brief
+///
+/// Reads the next number, skipping the white space before it
+/// \param const char*& p - position to read from, moved past the
+/// number, or to the start of what follows the white space if it
+/// is not a number
+/// \param const char* end - one past the last character
+/// \param unsigned long long& / double& value - set to the number read
+/// \return bool - true if a number was read
+bool TextGraphReader::readNumber(const char*& p, const char* end, unsigned long long& value){
+    while (p < end && isSpace(*p)) {
+        p++;
+    }
+    std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc()) return false;
+    p = result.ptr;
+    return true;
+}
+
+bool TextGraphReader::readNumber(const char*& p, const char* end, double& value){
+    while (p < end && isSpace(*p)) {
+        p++;
+    }
+    std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc()) return false;
+    p = result.ptr;
+    return true;
+}
+
+/// \brief
+///
+/// Skips the spaces and tabs on the rest of a line, stopping
+/// at the line break or the first other character
+/// \param const char*& p - position to read from, moved past the spaces
+/// \param const char* end - one past the last character
+/// \return bool - true if nothing else is left on the line
+bool TextGraphReader::atLineEnd(const char*& p, const char* end){
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+    return p == end || *p == '\n';
+}
+
+/// \brief
+///
+/// Checks whether a character separates numbers
+/// \param char - character
+/// \return bool - true if white space
+bool TextGraphReader::isSpace(char c){
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
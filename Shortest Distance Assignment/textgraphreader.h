@@ -0,0 +1,168 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: textgraphreader.h
+/// Header of TextGraphReader class
+/// Encapsulates a reader of graph text files that maps the
+/// whole file and parses its numbers across threads
+
+#ifndef _textgraphreader_h
+#define _textgraphreader_h
+
+#include <vector>
+
+#include "edge.h"
+
+/// Encapsulates a reader of the two graph text formats. Both start with
+/// the number of cities followed by the co-ordinates of every city. In the
+/// dense format read by roads the first line holds only the number of cities,
+/// and the co-ordinates are followed by one 0 or 1 flag for every pair of
+/// cities i < j saying whether they are joined. In the sparse format the
+/// first line also holds the number of edges, and the co-ordinates are
+/// followed by one line per edge holding the IDs of its end points and
+/// optionally its weight. Edges without a weight are weighted by the
+/// distance between their end points, as roads weights them.
+/// The file is mapped rather than read through a stream, numbers are parsed
+/// with std::from_chars, which consults no locale, and flags are checked
+/// character by character. The edge section
+/// is split into blocks parsed by separate threads, and the edges of the
+/// blocks are joined in file order so they are listed as roads adds them
+class TextGraphReader {
+
+    public:
+
+        /// \brief
+        ///
+        /// Constructor, initializes a reader that has read nothing
+        TextGraphReader();
+
+        /// \brief
+        ///
+        /// Destructor, no objects dynamically created from this class
+        ~TextGraphReader();
+
+        /// \brief
+        ///
+        /// Reads a graph text file in either format, replacing
+        /// anything read before
+        /// \param const char* fileName - name of the file
+        /// \param unsigned int numThreads - number of threads parsing the edges,
+        /// 0 for one per hardware thread
+        /// \return bool - true if the file was found and every number in it
+        /// read, false if it is missing, cut short or holds anything else
+        bool read(const char* fileName, unsigned int numThreads);
+
+        /// \brief
+        ///
+        /// Simple getter for whether the file read was in the sparse format
+        /// \return bool - true if sparse
+        bool isSparse();
+
+        /// \brief
+        ///
+        /// Simple getter for the number of cities read
+        /// \return unsigned int - number of vertices
+        unsigned int getNumVertices();
+
+        /// \brief
+        ///
+        /// Simple getter for the co-ordinates read, x and y of every city in pairs
+        /// \return const vector<double>& - co-ordinates
+        const std::vector<double>& getCoordinates();
+
+        /// \brief
+        ///
+        /// Simple getter for the edges read, in the order they appear in the file
+        /// \return const vector<WeightedEdge>& - edges
+        const std::vector<WeightedEdge>& getEdges();
+
+    private:
+
+        // Instance variables storing whether the file is in the sparse
+        // format, the number of cities, their co-ordinates and the edges
+        bool sparse;
+        unsigned int numVertices;
+        std::vector<double> coordinates;
+        std::vector<WeightedEdge> edges;
+
+        /// \brief
+        ///
+        /// Parses the text of a graph file in either format
+        /// \param const char* text - first character
+        /// \param const char* end - one past the last character
+        /// \param unsigned int numThreads - number of threads parsing the edges
+        /// \return bool - true if every number was read
+        bool parse(const char* text, const char* end, unsigned int numThreads);
+
+        /// \brief
+        ///
+        /// Parses the edge flags of the dense format, each block of the text
+        /// counting its flags first so it knows which pair its first flag is for
+        /// \param const char* text - first character of the flags
+        /// \param const char* end - one past the last character
+        /// \param unsigned int numThreads - number of threads
+        /// \return bool - true if every pair has a flag of 0 or 1 and nothing follows
+        bool parseFlags(const char* text, const char* end, unsigned int numThreads);
+
+        /// \brief
+        ///
+        /// Parses the edge lines of the sparse format, in blocks of whole lines
+        /// \param const char* text - first character of the edge lines
+        /// \param const char* end - one past the last character
+        /// \param unsigned long long numEdges - number of edges in the file
+        /// \param unsigned int numThreads - number of threads
+        /// \return bool - true if every line names two cities and
+        /// there are as many lines as edges
+        bool parseEdgeLines(const char* text, const char* end, unsigned long long numEdges,
+                            unsigned int numThreads);
+
+        /// \brief
+        ///
+        /// Splits text into blocks of about the same size, moving each
+        /// boundary forward past the next separator character
+        /// \param const char* text - first character
+        /// \param const char* end - one past the last character
+        /// \param bool lines - true to split at line breaks, false at any white space
+        /// \param vector<const char*>& bounds - filled with the first character of
+        /// every block followed by end
+        void split(const char* text, const char* end, bool lines, std::vector<const char*>& bounds);
+
+        /// \brief
+        ///
+        /// Straight line distance between two cities, calculated
+        /// exactly as Point::distanceTo calculates it
+        /// \param unsigned int u - first city
+        /// \param unsigned int v - second city
+        /// \return double - distance
+        double distanceBetween(unsigned int u, unsigned int v);
+
+        /// \brief
+        ///
+        /// Reads the next number, skipping the white space before it
+        /// \param const char*& p - position to read from, moved past the
+        /// number, or to the start of what follows the white space if it
+        /// is not a number
+        /// \param const char* end - one past the last character
+        /// \param unsigned long long& / double& value - set to the number read
+        /// \return bool - true if a number was read
+        bool readNumber(const char*& p, const char* end, unsigned long long& value);
+        bool readNumber(const char*& p, const char* end, double& value);
+
+        /// \brief
+        ///
+        /// Skips the spaces and tabs on the rest of a line, stopping
+        /// at the line break or the first other character
+        /// \param const char*& p - position to read from, moved past the spaces
+        /// \param const char* end - one past the last character
+        /// \return bool - true if nothing else is left on the line
+        bool atLineEnd(const char*& p, const char* end);
+
+        /// \brief
+        ///
+        /// Checks whether a character separates numbers
+        /// \param char - character
+        /// \return bool - true if white space
+        bool isSpace(char);
+
+};
+
+#endif // _textgraphreader_h
@@ -0,0 +1,227 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: threadpool.cpp
+/// Implementation of ThreadPool class
+/// Encapsulates a fixed set of worker threads that share
+/// the iterations of parallel loops
+
+#include "threadpool.h"
+
+// Constant defining how many chunks each worker gets on average,
+// more chunks balance uneven iterations at the cost of more claims
+const unsigned int CHUNKS_PER_WORKER = 8;
+
+/// Encapsulates a fixed set of worker threads kept alive between loops,
+/// so parallel phases that repeat many times (rounds of an algorithm) do
+/// not pay for thread creation each time. The thread calling parallelFor
+/// works alongside the pool and is always worker 0. Each loop is split into
+/// one contiguous range per worker, a worker takes chunks from the front of
+/// its own range and once it runs dry steals the back half of another's,
+/// so uneven iterations balance without every claim hitting one counter
+
+/// \brief
+///
+/// Constructor, starts the worker threads
+/// \param unsigned int - total number of workers including the
+/// calling thread, 0 for one per hardware thread
+ThreadPool::ThreadPool(unsigned int numWorkers){
+
+    if (numWorkers == 0) {
+        numWorkers = std::thread::hardware_concurrency();
+    }
+    if (numWorkers == 0) {
+        numWorkers = 1;
+    }
+
+    body = NULL;
+    count = 0;
+    chunk = 1;
+    busy = 0;
+    generation = 0;
+    stopping = false;
+
+    ranges = std::vector<Range>(numWorkers);
+    for (unsigned int id = 0; id < numWorkers; id++) {
+        ranges[id].bounds.store(0);
+    }
+
+    for (unsigned int id = 1; id < numWorkers; id++) {
+        helpers.push_back(std::thread(&ThreadPool::work, this, id));
+    }
+}
+
+/// \brief
+///
+/// Destructor, stops and joins the worker threads
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    started.notify_all();
+
+    for (unsigned i = 0; i < helpers.size(); i++) {
+        helpers[i].join();
+    }
+}
+
+/// \brief
+///
+/// Simple getter for the number of workers, including the calling thread
+/// \return unsigned int - number of workers
+unsigned int ThreadPool::getNumWorkers(){
+    return helpers.size() + 1;
+}
+
+/// \brief
+///
+/// Calls a function once for every index in [0, count), spreading the
+/// indices across the workers in chunks, and returns when all are done
+/// \param unsigned int count - number of indices
+/// \param function body - called with the index and the ID of the
+/// worker in [0, getNumWorkers()) running it
+void ThreadPool::parallelFor(unsigned int count, const std::function<void(unsigned int, unsigned int)>& body){
+
+    // Small loops, or a pool without helpers, run on the calling thread
+    if (helpers.empty() || count < 2) {
+        for (unsigned int i = 0; i < count; i++) {
+            body(i, 0);
+        }
+        return;
+    }
+
+    // Publish the loop with an equal share of it in every
+    // worker's range and wake the helpers
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->body = &body;
+        this->count = count;
+        unsigned int numWorkers = getNumWorkers();
+        chunk = count / (numWorkers * CHUNKS_PER_WORKER);
+        if (chunk == 0) chunk = 1;
+        for (unsigned int id = 0; id < numWorkers; id++) {
+            unsigned int begin = (unsigned long long)count * id / numWorkers;
+            unsigned int end = (unsigned long long)count * (id + 1) / numWorkers;
+            ranges[id].bounds.store(packRange(begin, end), std::memory_order_relaxed);
+        }
+        busy = helpers.size();
+        generation++;
+    }
+    started.notify_all();
+
+    runChunks(0);
+
+    // Wait for the helpers to finish their last chunks
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return busy == 0; });
+    this->body = NULL;
+}
+
+/// \brief
+///
+/// Main loop of a helper thread, waits for each loop and runs its share
+/// \param unsigned int - worker ID
+void ThreadPool::work(unsigned int id){
+
+    unsigned long seen = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            started.wait(lock, [this, seen] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        runChunks(id);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy--;
+            if (busy == 0) finished.notify_one();
+        }
+    }
+}
+
+/// \brief
+///
+/// Claims and runs chunks of the current loop until none are left
+/// \param unsigned int - worker ID
+void ThreadPool::runChunks(unsigned int id){
+
+    unsigned int begin, end;
+    while (true) {
+        if (!claim(id, begin, end) && !(steal(id) && claim(id, begin, end))) return;
+
+        for (unsigned int i = begin; i < end; i++) {
+            (*body)(i, id);
+        }
+    }
+}
+
+/// \brief
+///
+/// Claims a chunk from the front of a worker's own range
+/// \param unsigned int id - worker ID
+/// \param unsigned int& begin - set to the first index claimed
+/// \param unsigned int& end - set to one past the last index claimed
+/// \return bool - false if the range was empty
+bool ThreadPool::claim(unsigned int id, unsigned int& begin, unsigned int& end){
+
+    std::atomic<unsigned long long>& bounds = ranges[id].bounds;
+    unsigned long long current = bounds.load(std::memory_order_acquire);
+
+    while (true) {
+        unsigned int first = (unsigned int)current;
+        unsigned int last = (unsigned int)(current >> 32);
+        if (first >= last) return false;
+
+        unsigned int split = last - first > chunk ? first + chunk : last;
+        if (bounds.compare_exchange_weak(current, packRange(split, last), std::memory_order_acq_rel)) {
+            begin = first;
+            end = split;
+            return true;
+        }
+    }
+}
+
+/// \brief
+///
+/// Moves the back half of another worker's range into a worker's own
+/// \param unsigned int id - worker ID of the thief
+/// \return bool - false if every other range was empty
+bool ThreadPool::steal(unsigned int id){
+
+    // Visit the other workers starting from the next one, so
+    // thieves spread out instead of all robbing worker 0
+    unsigned int numWorkers = getNumWorkers();
+    for (unsigned int k = 1; k < numWorkers; k++) {
+        std::atomic<unsigned long long>& bounds = ranges[(id + k) % numWorkers].bounds;
+        unsigned long long current = bounds.load(std::memory_order_acquire);
+
+        while (true) {
+            unsigned int first = (unsigned int)current;
+            unsigned int last = (unsigned int)(current >> 32);
+            if (first >= last) break;
+
+            // The owner keeps the front, a lone index is taken whole. Only the
+            // owner writes to an empty range, so no other thief races this store
+            unsigned int split = last - (last - first + 1) / 2;
+            if (bounds.compare_exchange_weak(current, packRange(first, split), std::memory_order_acq_rel)) {
+                ranges[id].bounds.store(packRange(split, last), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/// \brief
+///
+/// Packs a range of indices into the value held by a worker's range
+/// \param unsigned int begin - first index
+/// \param unsigned int end - one past the last index
+/// \return unsigned long long - packed range
+unsigned long long ThreadPool::packRange(unsigned int begin, unsigned int end){
+    return ((unsigned long long)end << 32) | begin;
+}
@@ -0,0 +1,121 @@
+/// Created by Phuc Tran 08908184
+///
+/// File: threadpool.h
+/// Header of ThreadPool class
+/// Encapsulates a fixed set of worker threads that share
+/// the iterations of parallel loops
+
+#ifndef _threadpool_h
+#define _threadpool_h
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+/// Encapsulates a fixed set of worker threads kept alive between loops,
+/// so parallel phases that repeat many times (rounds of an algorithm) do
+/// not pay for thread creation each time. The thread calling parallelFor
+/// works alongside the pool and is always worker 0. Each loop is split into
+/// one contiguous range per worker, a worker takes chunks from the front of
+/// its own range and once it runs dry steals the back half of another's,
+/// so uneven iterations balance without every claim hitting one counter
+class ThreadPool {
+
+    public:
+
+        /// \brief
+        ///
+        /// Constructor, starts the worker threads
+        /// \param unsigned int - total number of workers including the
+        /// calling thread, 0 for one per hardware thread
+        ThreadPool(unsigned int);
+
+        /// \brief
+        ///
+        /// Destructor, stops and joins the worker threads
+        ~ThreadPool();
+
+        /// \brief
+        ///
+        /// Simple getter for the number of workers, including the calling thread
+        /// \return unsigned int - number of workers
+        unsigned int getNumWorkers();
+
+        /// \brief
+        ///
+        /// Calls a function once for every index in [0, count), spreading the
+        /// indices across the workers in chunks, and returns when all are done.
+        /// Indices are started in increasing order within each worker's range
+        /// \param unsigned int count - number of indices
+        /// \param function body - called with the index and the ID of the
+        /// worker in [0, getNumWorkers()) running it
+        void parallelFor(unsigned int count, const std::function<void(unsigned int, unsigned int)>& body);
+
+    private:
+
+        // Range of indices left to a worker, the first index in the low half
+        // and one past the last in the high half so both change in one swap,
+        // padded to a cache line so workers do not slow each other down
+        struct alignas(64) Range {
+            std::atomic<unsigned long long> bounds;
+        };
+
+        // Instance variables storing the helper threads, the lock and signals
+        // guarding the current loop, the loop's body, size, chunk size and the
+        // range of unclaimed indices of each worker, how many helpers are still
+        // busy with it, and a counter identifying each loop so helpers join
+        // every loop exactly once
+        std::vector<std::thread> helpers;
+        std::mutex mutex;
+        std::condition_variable started;
+        std::condition_variable finished;
+        const std::function<void(unsigned int, unsigned int)>* body;
+        unsigned int count;
+        unsigned int chunk;
+        std::vector<Range> ranges;
+        unsigned int busy;
+        unsigned long generation;
+        bool stopping;
+
+        /// \brief
+        ///
+        /// Main loop of a helper thread, waits for each loop and runs its share
+        /// \param unsigned int - worker ID
+        void work(unsigned int);
+
+        /// \brief
+        ///
+        /// Claims and runs chunks of the current loop until none are left
+        /// \param unsigned int - worker ID
+        void runChunks(unsigned int);
+
+        /// \brief
+        ///
+        /// Claims a chunk from the front of a worker's own range
+        /// \param unsigned int id - worker ID
+        /// \param unsigned int& begin - set to the first index claimed
+        /// \param unsigned int& end - set to one past the last index claimed
+        /// \return bool - false if the range was empty
+        bool claim(unsigned int id, unsigned int& begin, unsigned int& end);
+
+        /// \brief
+        ///
+        /// Moves the back half of another worker's range into a worker's own
+        /// \param unsigned int id - worker ID of the thief
+        /// \return bool - false if every other range was empty
+        bool steal(unsigned int id);
+
+        /// \brief
+        ///
+        /// Packs a range of indices into the value held by a worker's range
+        /// \param unsigned int begin - first index
+        /// \param unsigned int end - one past the last index
+        /// \return unsigned long long - packed range
+        unsigned long long packRange(unsigned int begin, unsigned int end);
+
+};
+
+#endif // _threadpool_h
@@ -10,10 +10,10 @@
 
 /// Encapsulates instance variables to emulate a vertex,
 /// with instance variables for storing the vertex's
-/// ID, adjacent vertex IDs, the directly preceding vertex's ID,
-/// it's discovery states, the minimum distance between the vertex and
-/// a source vertex and functions to alter access these variables, sort vertices
-/// and outputting the vertex for debugging purposes
+/// ID and adjacent vertex IDs and functions to alter access
+/// these variables and outputting the vertex for debugging purposes.
+/// The state of shortest path searches is kept in a QueryContext instead,
+/// so searches never write to the vertices
 Vertex::Vertex(){
 }
 
@@ -49,97 +49,40 @@ void Vertex::addAdjacency(unsigned int a){
 
 /// \brief
 ///
-/// Simple getter for the vertex's collection of adjacencies
-/// \return <unsigned int>* - pointer to the adjacencies collection
-std::set<unsigned int>* Vertex::getAdjacencies(){
-    return &adjacencies;
-}
-
-/// \brief
-///
-/// Mutator for altering the discovered state of the vertex
-/// \param bool - true or false for discovered or not
-void Vertex::setDiscovered(bool d){
-    discovered = d;
-}
-
-/// \brief
-///
-/// Simple getter for the vertice's discovered state
-/// \return bool - true or false for discovered or not
-bool Vertex::isDiscovered(){
-    return discovered;
-}
-
-/// \brief
-///
-/// Mutator for altering the vertex's predeccesor
-/// \param unsigned int - preceding vertex's identifier
-void Vertex::setPredecessorId(unsigned int p){
-    predecessorId = p;
-}
-
-/// \brief
-///
-/// Simple getter for the vertex's predeccesor
-/// \return unsigned int - preceding vertex's identifier
-unsigned int Vertex::getPredecessorId(){
-    return predecessorId;
-}
-
-/// \brief
-///
-/// Mutator for altering minimum distance between the vertex
-/// and a source vertex, used in dijkstra's algorithm
-/// \param double - minimum distance between this vertex and the source
-void Vertex::setMinDistance(double d){
-    minDistance = d;
+/// Removes the ID of another vertex from the adjacencies collection
+/// \param unsigned int - other vertex's ID
+void Vertex::removeAdjacency(unsigned int a){
+    adjacencies.erase(a);
 }
 
 /// \brief
 ///
-/// Simple getter for the minimum distance between the vertex
-/// and a source vertex, used in dijkstra's algorithm
-/// \return double - minimum distance between this vertex and the source
-double Vertex::getMinDistance(){
-    return minDistance;
+/// Removes every ID from the adjacencies collection
+void Vertex::clearAdjacencies(){
+    adjacencies.clear();
 }
 
 /// \brief
 ///
-/// Boolean operator for comparing vertices by their minimum distances to the source
-/// \param Vertex* source - pointer to first vertex
-/// \param Vertex* destination - pointer to second vertex
-/// \return bool - true if first vertex's minimum distance is >= second's
-bool Vertex::operator()(Vertex* first, Vertex* second) {
-    return first->getMinDistance() >= second->getMinDistance();
+/// Simple getter for the vertex's collection of adjacencies
+/// \return <unsigned int>* - pointer to the adjacencies collection
+std::set<unsigned int>* Vertex::getAdjacencies(){
+    return &adjacencies;
 }
 
 /// \brief
 ///
 /// Ostream operator overload
 /// Outputs string representing the vertex in the format:
-/// V:identifier:predecessorID:discovered:minDistance:adjacencies
-/// e.g. V:1:2:T:1.23:2|3|4|
+/// V:identifier:adjacencies
+/// e.g. V:1:2|3|4|
 /// \param out - output
 /// \param vertex - reference to the vertex
 /// \return ostream& - outputs string representation of vertex
 std::ostream& operator<<(std::ostream& out, Vertex& vertex) {
 
-    std::string found;
-
-    // Set string representation of discovery state
-    if(vertex.isDiscovered()) {
-        found = "T";
-    } else {
-        found = "F";
-    }
-
     // Output variables
     out << "V:" << vertex.getId()<< ":"
-    << vertex.getPredecessorId() << ":"
-    << found << ":"
-    << vertex.getMinDistance() << ":"
     << vertex.adjacenciesToString();
 
     return out;
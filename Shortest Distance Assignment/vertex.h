@@ -16,10 +16,10 @@
 #include <sstream>
 
 /// Encapsulates instance variables to emulate a vertex,
-/// Stores the vertex's ID, adjacent vertex IDs, the directly preceding vertex's ID,
-/// it's discovery states, the minimum distance between the vertex and
-/// a source vertex and functions to alter access these variables, sort vertices
-/// and outputting the vertex for debugging purposes
+/// Stores the vertex's ID and adjacent vertex IDs and functions to alter
+/// access these variables and outputting the vertex for debugging purposes.
+/// The state of shortest path searches is kept in a QueryContext instead,
+/// so searches never write to the vertices
 class Vertex{
 
     public:
@@ -54,62 +54,27 @@ class Vertex{
 
         /// \brief
         ///
-        /// Simple getter for the vertex's collection of adjacencies
-        /// \return <unsigned int>* - pointer to the adjacencies collection
-        std::set<unsigned int>* getAdjacencies();
-
-        /// \brief
-        ///
-        /// Mutator for altering the discovered state of the vertex
-        /// \param bool - true or false for discovered or not
-        void setDiscovered(bool);
-
-        /// \brief
-        ///
-        /// Simple getter for the vertice's discovered state
-        /// \return bool - true or false for discovered or not
-        bool isDiscovered();
-
-        /// \brief
-        ///
-        /// Mutator for altering the vertex's predeccesor
-        /// \param unsigned int - preceding vertex's identifier
-        void setPredecessorId(unsigned int);
-
-        /// \brief
-        ///
-        /// Simple getter for the vertex's predeccesor
-        /// \return unsigned int - preceding vertex's identifier
-        unsigned int getPredecessorId();
-
-        /// \brief
-        ///
-        /// Mutator for altering minimum distance between the vertex
-        /// and a source vertex, used in dijkstra's algorithm
-        /// \param double - minimum distance between this vertex and the source
-        void setMinDistance(double);
+        /// Removes the ID of another vertex from the adjacencies collection
+        /// \param unsigned int - other vertex's ID
+        void removeAdjacency(unsigned int);
 
         /// \brief
         ///
-        /// Simple getter for the minimum distance between the vertex
-        /// and a source vertex, used in dijkstra's algorithm
-        /// \return double - minimum distance between this vertex and the source
-        double getMinDistance();
+        /// Removes every ID from the adjacencies collection
+        void clearAdjacencies();
 
         /// \brief
         ///
-        /// Boolean operator for comparing vertices by their minimum distances to the source
-        /// \param Vertex* source - pointer to first vertex
-        /// \param Vertex* destination - pointer to second vertex
-        /// \return bool - true if first vertex's minimum distance is >= second's
-        bool operator()(Vertex* first, Vertex* second);
+        /// Simple getter for the vertex's collection of adjacencies
+        /// \return <unsigned int>* - pointer to the adjacencies collection
+        std::set<unsigned int>* getAdjacencies();
 
         /// \brief
         ///
         /// Ostream operator overload
         /// Outputs string representing the vertex in the format:
-        /// V:identifier:predecessorID:discovered:minDistance:adjacencies
-        /// e.g. V:1:2:T:1.23:2|3|4|
+        /// V:identifier:adjacencies
+        /// e.g. V:1:2|3|4|
         /// \param out - output
         /// \param vertex - reference to the vertex
         /// \return ostream& - outputs string representation of vertex
@@ -117,14 +82,9 @@ class Vertex{
 
     private:
 
-        // Instance variable storing the vertex's ID, adjacencies, discovery
-        // state, vertex's predecessor's ID and the vertex's minimum distance to
-        // a vertex source
+        // Instance variable storing the vertex's ID and adjacencies
         unsigned int identifier;
         std::set<unsigned int> adjacencies;
-        bool discovered;
-        unsigned int predecessorId;
-        double minDistance;
 
         /// \brief
         ///